@@ -0,0 +1,233 @@
+
+# include <chrono>
+# include <string>
+# include <vector>
+# include <cstdlib>
+# include <iostream>
+# include <algorithm>
+# include <time.h>
+# include <sys/resource.h>
+# include <sdl_core/SdlWidget.hh>
+# include "SdlApplication.hh"
+
+namespace sdl {
+  namespace app {
+    namespace bench {
+
+      /**
+       * @brief - Widget simulating an expensive content: each repaint busy
+       *          waits for the configured duration. The content can be marked
+       *          as dirty so that it is repainted on the next frame.
+       */
+      class CostlyWidget: public core::SdlWidget {
+        public:
+
+          CostlyWidget(const std::string& name,
+                       unsigned cost):
+            core::SdlWidget(name, utils::Sizef(), nullptr),
+            m_cost(cost)
+          {}
+
+          void
+          invalidateContent() noexcept {
+            makeContentDirty();
+          }
+
+        protected:
+
+          void
+          drawContentPrivate(const utils::Uuid& uuid,
+                             const utils::Boxf& area) override
+          {
+            core::SdlWidget::drawContentPrivate(uuid, area);
+
+            const auto end = std::chrono::steady_clock::now() + std::chrono::microseconds(m_cost);
+            while (std::chrono::steady_clock::now() < end) {
+              // Busy wait to simulate an expensive rendering.
+            }
+          }
+
+        private:
+
+          unsigned m_cost;
+      };
+
+      /**
+       * @brief - Collects the timestamps of each frame and the resources used by
+       *          the process while the application runs.
+       */
+      class FrameProbe {
+        public:
+
+          FrameProbe(SdlApplication& app,
+                     CostlyWidget* central,
+                     unsigned frames):
+            m_app(app),
+            m_central(central),
+            m_frames(frames),
+            m_timestamps(),
+            m_cpuStart(0.0),
+            m_cpuEnd(0.0)
+          {
+            m_timestamps.reserve(frames + 1u);
+          }
+
+          /**
+           * @brief - Called once per frame from the main thread through a task
+           *          which posts itself again. The application is stopped once
+           *          the requested number of frames is reached.
+           */
+          void
+          onFrame() {
+            if (m_timestamps.empty()) {
+              m_cpuStart = cpuTime();
+            }
+
+            m_timestamps.push_back(std::chrono::steady_clock::now());
+
+            if (m_timestamps.size() > m_frames) {
+              m_cpuEnd = cpuTime();
+              m_app.quit();
+              return;
+            }
+
+            // Force the central widget to be repainted on the next frame.
+            m_central->invalidateContent();
+
+            m_app.postTask([this]() { onFrame(); });
+          }
+
+          std::string
+          toJson() const {
+            std::vector<float> durations;
+            for (unsigned id = 1u ; id < m_timestamps.size() ; ++id) {
+              durations.push_back(std::chrono::duration_cast<std::chrono::microseconds>(m_timestamps[id] - m_timestamps[id - 1u]).count() / 1000.0f);
+            }
+
+            std::sort(durations.begin(), durations.end());
+
+            float total = 0.0f;
+            for (unsigned id = 0u ; id < durations.size() ; ++id) {
+              total += durations[id];
+            }
+
+            const unsigned count = durations.size();
+            const float fps = (total > 0.0f ? 1000.0f * count / total : 0.0f);
+            const double cpu = (count > 0u ? 1000.0 * (m_cpuEnd - m_cpuStart) / count : 0.0);
+
+            struct rusage usage;
+            getrusage(RUSAGE_SELF, &usage);
+
+            return
+              std::string("{") +
+              "\"frames\": " + std::to_string(count) + ", " +
+              "\"fps\": " + std::to_string(fps) + ", " +
+              "\"frame_p50_ms\": " + std::to_string(percentile(durations, 0.5f)) + ", " +
+              "\"frame_p95_ms\": " + std::to_string(percentile(durations, 0.95f)) + ", " +
+              "\"frame_p99_ms\": " + std::to_string(percentile(durations, 0.99f)) + ", " +
+              "\"frame_max_ms\": " + std::to_string(percentile(durations, 1.0f)) + ", " +
+              "\"cpu_per_frame_ms\": " + std::to_string(cpu) + ", " +
+              "\"peak_rss_kb\": " + std::to_string(usage.ru_maxrss) +
+              "}";
+          }
+
+        private:
+
+          static
+          double
+          cpuTime() noexcept {
+            struct timespec ts;
+            clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+
+            return ts.tv_sec + ts.tv_nsec / 1e9;
+          }
+
+          static
+          float
+          percentile(const std::vector<float>& sorted,
+                     float p)
+          {
+            if (sorted.empty()) {
+              return 0.0f;
+            }
+
+            return sorted[static_cast<unsigned>(p * (sorted.size() - 1u))];
+          }
+
+        private:
+
+          SdlApplication& m_app;
+          CostlyWidget* m_central;
+          unsigned m_frames;
+
+          std::vector<std::chrono::steady_clock::time_point> m_timestamps;
+          double m_cpuStart;
+          double m_cpuEnd;
+      };
+
+    }
+  }
+}
+
+int main(int argc, char** argv) {
+  // Usage: frame_benchmark [docks per area] [central cost in us] [frames] [framerate]
+  const unsigned docks = (argc > 1 ? std::max(0, std::atoi(argv[1])) : 2);
+  const unsigned cost = (argc > 2 ? std::max(0, std::atoi(argv[2])) : 2000);
+  const unsigned frames = (argc > 3 ? std::max(1, std::atoi(argv[3])) : 600);
+  const float framerate = (argc > 4 ? std::max(1.0f, static_cast<float>(std::atof(argv[4]))) : 60.0f);
+
+  // Run without a display unless the user requested a specific driver.
+  setenv("SDL_VIDEODRIVER", "dummy", 0);
+
+  sdl::app::SdlApplication app(
+    std::string("frame_benchmark"),
+    std::string("Frame benchmark"),
+    std::string(),
+    utils::Sizei(1280, 1024),
+    true,
+    utils::Sizef(0.7f, 0.5f),
+    framerate
+  );
+
+  const std::vector<sdl::app::DockWidgetArea> areas = {
+    sdl::app::DockWidgetArea::TopArea,
+    sdl::app::DockWidgetArea::LeftArea,
+    sdl::app::DockWidgetArea::RightArea,
+    sdl::app::DockWidgetArea::BottomArea
+  };
+
+  sdl::app::bench::CostlyWidget* central = new sdl::app::bench::CostlyWidget(std::string("central_widget"), cost);
+
+  // Build the synthetic widgets tree in a single batch.
+  {
+    const sdl::app::SdlApplication::UpdateBatch batch(app);
+
+    app.setMenuBar(new sdl::core::SdlWidget(std::string("menu_bar")));
+    app.addToolBar(new sdl::core::SdlWidget(std::string("tool_bar")));
+
+    for (unsigned id = 0u ; id < docks ; ++id) {
+      for (unsigned area = 0u ; area < areas.size() ; ++area) {
+        const std::string name = sdl::app::areaToName(areas[area]) + "_" + std::to_string(id);
+        app.addDockWidget(new sdl::core::SdlWidget(name), areas[area], name);
+      }
+    }
+
+    app.setCentralWidget(central);
+    app.setStatusBar(new sdl::core::SdlWidget(std::string("status_bar")));
+  }
+
+  sdl::app::bench::FrameProbe probe(app, central, frames);
+  app.postTask([&probe]() { probe.onFrame(); });
+
+  app.run();
+
+  std::cout << "{" << std::endl;
+  std::cout << "  \"benchmark\": \"frame_rate\"," << std::endl;
+  std::cout << "  \"docks_per_area\": " << docks << "," << std::endl;
+  std::cout << "  \"central_cost_us\": " << cost << "," << std::endl;
+  std::cout << "  \"target_fps\": " << framerate << "," << std::endl;
+  std::cout << "  \"result\": " << probe.toJson() << std::endl;
+  std::cout << "}" << std::endl;
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,314 @@
+
+# include <chrono>
+# include <string>
+# include <vector>
+# include <cstdlib>
+# include <iostream>
+# include <algorithm>
+# include <functional>
+# include <sdl_core/SdlWidget.hh>
+# include "MainWindowLayout.hh"
+
+namespace sdl {
+  namespace app {
+    namespace bench {
+
+      /**
+       * @brief - Convenience layout allowing to trigger the computation of the
+       *          geometry directly rather than through the events system.
+       */
+      class BenchmarkLayout: public MainWindowLayout {
+        public:
+
+          BenchmarkLayout():
+            MainWindowLayout(5.0f, utils::Sizef(0.7f, 0.5f))
+          {}
+
+          void
+          compute(const utils::Boxf& window) {
+            computeGeometry(window);
+          }
+      };
+
+      /**
+       * @brief - Holds the layout and the widgets used for a benchmark. The
+       *          layout is populated with `count` tool bars and `count` dock
+       *          widgets in each area along with a menu bar, a status bar and
+       *          a central widget. Unless `cached` is set the cache of the
+       *          layout is disabled so that each computation is a solve.
+       */
+      class Fixture {
+        public:
+
+          Fixture(unsigned count,
+                  bool cached):
+            m_layout(std::make_shared<BenchmarkLayout>()),
+            m_widgets(),
+            m_docks()
+          {
+            if (!cached) {
+              m_layout->setCacheCapacity(0u);
+            }
+
+            m_layout->setMenuBar(create("menu_bar"));
+
+            for (unsigned id = 0u ; id < count ; ++id) {
+              m_layout->addToolBar(create("tool_bar_" + std::to_string(id)));
+
+              for (DockWidgetArea area : getAreas()) {
+                core::SdlWidget* dock = create(areaToName(area) + "_" + std::to_string(id));
+                m_layout->addDockWidget(dock, area);
+                m_docks.push_back(std::make_pair(dock, area));
+              }
+            }
+
+            m_layout->setCentralWidget(create("central_widget"));
+            m_layout->setStatusBar(create("status_bar"));
+          }
+
+          ~Fixture() {
+            // Release the layout before the widgets it references.
+            m_layout.reset();
+
+            for (unsigned id = 0u ; id < m_widgets.size() ; ++id) {
+              delete m_widgets[id];
+            }
+          }
+
+          BenchmarkLayout&
+          layout() noexcept {
+            return *m_layout;
+          }
+
+          const std::vector<std::pair<core::SdlWidget*, DockWidgetArea>>&
+          docks() const noexcept {
+            return m_docks;
+          }
+
+          core::SdlWidget*
+          create(const std::string& name) {
+            m_widgets.push_back(new core::SdlWidget(name, utils::Sizef(), nullptr));
+            return m_widgets.back();
+          }
+
+        private:
+
+          static
+          std::vector<DockWidgetArea>
+          getAreas() {
+            return std::vector<DockWidgetArea>{
+              DockWidgetArea::TopArea,
+              DockWidgetArea::LeftArea,
+              DockWidgetArea::RightArea,
+              DockWidgetArea::BottomArea
+            };
+          }
+
+        private:
+
+          std::shared_ptr<BenchmarkLayout> m_layout;
+          std::vector<core::SdlWidget*> m_widgets;
+          std::vector<std::pair<core::SdlWidget*, DockWidgetArea>> m_docks;
+      };
+
+      /**
+       * @brief - Describes the timings collected for a scenario. Durations are
+       *          expressed in microseconds. The `cached` boolean indicates that
+       *          the layout was allowed to reuse previous solutions.
+       */
+      struct Result {
+        std::string name;
+        bool cached;
+        std::vector<float> samples;
+      };
+
+      float
+      elapsedSince(const std::chrono::steady_clock::time_point& start) {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count() / 1000.0f;
+      }
+
+      float
+      percentile(const std::vector<float>& sorted,
+                 float p)
+      {
+        if (sorted.empty()) {
+          return 0.0f;
+        }
+
+        const unsigned id = static_cast<unsigned>(p * (sorted.size() - 1u));
+        return sorted[id];
+      }
+
+      std::string
+      toJson(const Result& result) {
+        std::vector<float> sorted = result.samples;
+        std::sort(sorted.begin(), sorted.end());
+
+        float total = 0.0f;
+        for (unsigned id = 0u ; id < sorted.size() ; ++id) {
+          total += sorted[id];
+        }
+
+        const float mean = (sorted.empty() ? 0.0f : total / sorted.size());
+
+        return
+          std::string("{") +
+          "\"name\": \"" + result.name + "\", " +
+          "\"cached\": " + (result.cached ? "true" : "false") + ", " +
+          "\"samples\": " + std::to_string(sorted.size()) + ", " +
+          "\"mean_us\": " + std::to_string(mean) + ", " +
+          "\"min_us\": " + std::to_string(percentile(sorted, 0.0f)) + ", " +
+          "\"p50_us\": " + std::to_string(percentile(sorted, 0.5f)) + ", " +
+          "\"p95_us\": " + std::to_string(percentile(sorted, 0.95f)) + ", " +
+          "\"max_us\": " + std::to_string(percentile(sorted, 1.0f)) +
+          "}";
+      }
+
+      /**
+       * @brief - Measures the first computation of the geometry of a freshly
+       *          built layout: both internal layouts need to be solved.
+       */
+      Result
+      computeGeometry(unsigned count,
+                      unsigned iterations,
+                      bool cached)
+      {
+        Result result{"compute_geometry", cached, {}};
+        const utils::Boxf window = utils::Boxf::fromSize(utils::Sizef(1280.0f, 1024.0f));
+
+        for (unsigned it = 0u ; it < iterations ; ++it) {
+          Fixture fixture(count, cached);
+
+          auto start = std::chrono::steady_clock::now();
+          fixture.layout().compute(window);
+          result.samples.push_back(elapsedSince(start));
+        }
+
+        return result;
+      }
+
+      /**
+       * @brief - Measures the computation of the geometry while the window is
+       *          resized back and forth, as during a drag of its border.
+       */
+      Result
+      resizeSweep(unsigned count,
+                  unsigned iterations,
+                  bool cached)
+      {
+        Result result{"resize_sweep", cached, {}};
+        Fixture fixture(count, cached);
+
+        fixture.layout().compute(utils::Boxf::fromSize(utils::Sizef(640.0f, 480.0f)));
+
+        for (unsigned it = 0u ; it < iterations ; ++it) {
+          // Go back and forth between 640 and 1920 pixels.
+          const unsigned step = it % 320u;
+          const float w = 640.0f + 4.0f * (step < 160u ? step : 320u - step) * 2.0f;
+          const utils::Boxf window = utils::Boxf::fromSize(utils::Sizef(w, w * 0.75f));
+
+          auto start = std::chrono::steady_clock::now();
+          fixture.layout().compute(window);
+          result.samples.push_back(elapsedSince(start));
+        }
+
+        return result;
+      }
+
+      /**
+       * @brief - Measures the computation of the geometry when a dock widget is
+       *          alternatively shown and hidden, as when switching tabs.
+       */
+      Result
+      visibilityToggles(unsigned count,
+                        unsigned iterations,
+                        bool cached)
+      {
+        Result result{"visibility_toggles", cached, {}};
+        Fixture fixture(count, cached);
+        const utils::Boxf window = utils::Boxf::fromSize(utils::Sizef(1280.0f, 1024.0f));
+
+        fixture.layout().compute(window);
+
+        for (unsigned it = 0u ; it < iterations ; ++it) {
+          core::SdlWidget* dock = fixture.docks()[it % fixture.docks().size()].first;
+          dock->setVisible(!dock->isVisible());
+
+          auto start = std::chrono::steady_clock::now();
+          fixture.layout().compute(window);
+          result.samples.push_back(elapsedSince(start));
+        }
+
+        return result;
+      }
+
+      /**
+       * @brief - Measures the insertion and removal of dock widgets followed by
+       *          a computation of the geometry.
+       */
+      Result
+      insertRemoveChurn(unsigned count,
+                        unsigned iterations,
+                        bool cached)
+      {
+        Result result{"insert_remove_churn", cached, {}};
+        Fixture fixture(count, cached);
+        const utils::Boxf window = utils::Boxf::fromSize(utils::Sizef(1280.0f, 1024.0f));
+
+        fixture.layout().compute(window);
+
+        core::SdlWidget* dock = fixture.create("churn_dock");
+
+        for (unsigned it = 0u ; it < iterations ; ++it) {
+          auto start = std::chrono::steady_clock::now();
+
+          fixture.layout().addDockWidget(dock, DockWidgetArea::LeftArea);
+          fixture.layout().compute(window);
+          fixture.layout().removeDockWidget(dock);
+          fixture.layout().compute(window);
+
+          result.samples.push_back(elapsedSince(start));
+        }
+
+        return result;
+      }
+
+    }
+  }
+}
+
+int main(int argc, char** argv) {
+  // Usage: layout_benchmark [count] [iterations]
+  const unsigned count = (argc > 1 ? std::max(1, std::atoi(argv[1])) : 8);
+  const unsigned iterations = (argc > 2 ? std::max(1, std::atoi(argv[2])) : 200);
+
+  using Scenario = std::function<sdl::app::bench::Result(unsigned, unsigned, bool)>;
+
+  const std::vector<Scenario> scenarios = {
+    &sdl::app::bench::computeGeometry,
+    &sdl::app::bench::resizeSweep,
+    &sdl::app::bench::visibilityToggles,
+    &sdl::app::bench::insertRemoveChurn
+  };
+
+  std::cout << "{" << std::endl;
+  std::cout << "  \"benchmark\": \"main_window_layout\"," << std::endl;
+  std::cout << "  \"count\": " << count << "," << std::endl;
+  std::cout << "  \"iterations\": " << iterations << "," << std::endl;
+  std::cout << "  \"results\": [" << std::endl;
+
+  // Each scenario is run with the cache of the layout disabled, to measure
+  // the actual solves, and then enabled.
+  for (unsigned id = 0u ; id < scenarios.size() ; ++id) {
+    const sdl::app::bench::Result uncached = scenarios[id](count, iterations, false);
+    const sdl::app::bench::Result cached = scenarios[id](count, iterations, true);
+
+    std::cout << "    " << sdl::app::bench::toJson(uncached) << "," << std::endl;
+    std::cout << "    " << sdl::app::bench::toJson(cached) << (id + 1u < scenarios.size() ? "," : "") << std::endl;
+  }
+
+  std::cout << "  ]" << std::endl;
+  std::cout << "}" << std::endl;
+
+  return EXIT_SUCCESS;
+}
@@ -1,5 +1,7 @@
 
 # include "AppDecorator.hh"
+# include <cmath>
+# include <algorithm>
 
 namespace sdl {
   namespace app {
@@ -11,8 +13,19 @@ namespace sdl {
       core::engine::EngineDecorator(engine, std::string("app_decorator")),
       m_canvas(canvas),
       m_palette(palette),
-      m_window(window)
-    {}
+      m_window(window),
+
+      m_windowSize(),
+      m_scale(1.0f),
+      m_compositionDuration(0.0f),
+
+      m_hidden(false)
+    {
+      // The canvas is initially created with the size of the window.
+      if (m_canvas.valid()) {
+        m_windowSize = core::engine::EngineDecorator::queryTexture(m_canvas);
+      }
+    }
 
     AppDecorator::~AppDecorator() {
       // Destroy the window and main canvases if any.
@@ -24,6 +37,39 @@ namespace sdl {
       }
     }
 
+    void
+    AppDecorator::resizeCanvas(const utils::Sizef& window,
+                               float scale)
+    {
+      const utils::Sizef scaled(
+        std::max(1.0f, std::round(window.w() * scale)),
+        std::max(1.0f, std::round(window.h() * scale))
+      );
+
+      // Update the viewport of the renderer associated to the window if it
+      // was resized.
+      if (!(window == m_windowSize)) {
+        core::engine::EngineDecorator::updateViewport(
+          m_window,
+          utils::Boxf(window.w() / 2.0f, window.h() / 2.0f, window.w(), window.h())
+        );
+      }
+
+      // Release the current canvas and create a new one with the required
+      // dimensions.
+      if (m_canvas.valid()) {
+        destroyTexture(m_canvas);
+        m_canvas.invalidate();
+      }
+
+      m_canvas = core::engine::EngineDecorator::createTexture(m_window, scaled, core::engine::Palette::ColorRole::Background);
+      if (!m_canvas.valid()) {
+        error(std::string("Could not create window's canvas with size " + scaled.toString()));
+      }
+
+      m_windowSize = window;
+      m_scale = scale;
+    }
+
   }
 }
-
@@ -1,7 +1,10 @@
 #ifndef    APP_DECORATOR_HH
 # define   APP_DECORATOR_HH
 
+# include <atomic>
+# include <chrono>
 # include <memory>
+# include <sdl_core/SdlWidget.hh>
 # include <sdl_engine/EngineDecorator.hh>
 # include <sdl_engine/Palette.hh>
 
@@ -11,6 +14,14 @@ namespace sdl {
     class AppDecorator: public core::engine::EngineDecorator {
       public:
 
+        /**
+         * @brief - Creates a new decorator drawing on the `canvas` and presenting
+         *          it on the `window`.
+         * @param engine - the engine to decorate.
+         * @param canvas - the canvas on which widgets are drawn.
+         * @param palette - the palette used to clear the canvas.
+         * @param window - the window on which the canvas is presented.
+         */
         AppDecorator(core::engine::EngineShPtr engine,
                      const utils::Uuid& canvas,
                      const core::engine::Palette& palette,
@@ -18,12 +29,82 @@ namespace sdl {
 
         virtual ~AppDecorator();
 
+        /**
+         * @brief - Whether the window managed by this decorator is currently
+         *          hidden or minimized. This can be called from any thread.
+         * @return - `true` if the window is not visible.
+         */
+        bool
+        isWindowHidden() const noexcept;
+
+        /**
+         * @brief - Updates the visibility of the window managed by this decorator.
+         *          This is meant to be called by the owner of the window when the
+         *          system notifies that it was hidden or shown.
+         * @param hidden - `true` if the window is not visible anymore.
+         */
+        void
+        setWindowHidden(bool hidden) noexcept;
+
+        /**
+         * @brief - Assigns the canvas on which the content of the window is drawn.
+         *          The canvas persists across frames and is presented in full on
+         *          each call to `renderWindow`.
+         * @param canvas - the canvas to use.
+         */
         void
         setDrawingCanvas(const utils::Uuid& canvas);
 
+        /**
+         * @brief - Recreates the canvas so that it matches the input size of the
+         *          window multiplied by the `scale`. The viewport of the window is
+         *          updated if its size changed. Widgets are then drawn at this
+         *          scale and the canvas is stretched to the window when presented.
+         * @param window - the size of the window.
+         * @param scale - the scale of the canvas compared to the window.
+         */
+        void
+        resizeCanvas(const utils::Sizef& window,
+                     float scale = 1.0f);
+
+        /**
+         * @brief - Computes the area of the canvas where the input `widget` should
+         *          be drawn from its drawing area, which is expressed relatively to
+         *          the center of the window.
+         * @param widget - the widget for which the area should be computed.
+         * @return - the area of the widget expressed in the frame of the canvas.
+         */
+        utils::Boxf
+        getCanvasArea(const core::SdlWidget& widget) const;
+
+        /**
+         * @brief - Draws the input `widget` on the canvas at its drawing area.
+         * @param widget - the widget to draw.
+         */
+        void
+        drawWidget(core::SdlWidget& widget);
+
+        /**
+         * @brief - Returns the time spent composing the canvas since the last call
+         *          to this method, i.e. clearing it and drawing the textures of the
+         *          widgets on it. Unlike the drawing of the widgets themselves, this
+         *          cost depends on the scale of the canvas.
+         * @return - the time spent composing the canvas in milliseconds.
+         */
+        float
+        takeCompositionDuration() noexcept;
+
         void
         clearWindow(const utils::Uuid& uuid) override;
 
+        /**
+         * @brief - Clears the input `area` of the canvas with the background color
+         *          of the palette, leaving the rest of the canvas untouched.
+         * @param area - the area of the canvas to clear.
+         */
+        void
+        clearArea(const utils::Boxf& area);
+
         void
         renderWindow(const utils::Uuid& uuid) override;
 
@@ -74,6 +155,26 @@ namespace sdl {
         utils::Uuid m_canvas;
         core::engine::Palette m_palette;
         utils::Uuid m_window;
+
+        /**
+         * @brief - The size of the window and the scale of the canvas compared
+         *          to it, used to convert the areas of the widgets in the frame
+         *          of the canvas.
+         */
+        utils::Sizef m_windowSize;
+        float m_scale;
+
+        /**
+         * @brief - The time spent composing the canvas since the last call to the
+         *          `takeCompositionDuration` method, in milliseconds.
+         */
+        float m_compositionDuration;
+
+        /**
+         * @brief - Whether the window is currently hidden or minimized. It is
+         *          updated from the events thread and read by the rendering.
+         */
+        std::atomic<bool> m_hidden;
     };
 
     using AppDecoratorShPtr = std::shared_ptr<AppDecorator>;
@@ -17,6 +17,48 @@ namespace sdl {
       m_canvas = canvas;
     }
 
+    inline
+    utils::Boxf
+    AppDecorator::getCanvasArea(const core::SdlWidget& widget) const {
+      // Convert the drawing area of the widget, expressed relatively to the
+      // center of the window, into the frame of the canvas.
+      utils::Boxf render = widget.getDrawingArea();
+
+      render.x() += (m_windowSize.w() / 2.0f);
+      render.y() = (m_windowSize.h() / 2.0f) - render.y();
+
+      // Account for the scale of the canvas.
+      render.x() *= m_scale;
+      render.y() *= m_scale;
+      render.w() *= m_scale;
+      render.h() *= m_scale;
+
+      return render;
+    }
+
+    inline
+    void
+    AppDecorator::drawWidget(core::SdlWidget& widget) {
+      const utils::Uuid texture = widget.draw();
+      const utils::Boxf render = getCanvasArea(widget);
+
+      // Only the copy of the texture on the canvas is part of the composition.
+      const auto start = std::chrono::steady_clock::now();
+
+      drawTexture(texture, nullptr, nullptr, &render);
+
+      m_compositionDuration += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count() / 1000.0f;
+    }
+
+    inline
+    float
+    AppDecorator::takeCompositionDuration() noexcept {
+      const float duration = m_compositionDuration;
+      m_compositionDuration = 0.0f;
+
+      return duration;
+    }
+
     inline
     void
     AppDecorator::clearWindow(const utils::Uuid& /*uuid*/) {
@@ -24,7 +66,25 @@ namespace sdl {
         error(std::string("Cannot clear invalid canvas"));
       }
 
+      const auto start = std::chrono::steady_clock::now();
+
       core::engine::EngineDecorator::fillTexture(m_canvas, m_palette);
+
+      m_compositionDuration += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count() / 1000.0f;
+    }
+
+    inline
+    void
+    AppDecorator::clearArea(const utils::Boxf& area) {
+      if (!m_canvas.valid()) {
+        error(std::string("Cannot clear invalid canvas"));
+      }
+
+      const auto start = std::chrono::steady_clock::now();
+
+      core::engine::EngineDecorator::fillTexture(m_canvas, m_palette, &area);
+
+      m_compositionDuration += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count() / 1000.0f;
     }
 
     inline
@@ -43,6 +103,18 @@ namespace sdl {
       core::engine::EngineDecorator::renderWindow(uuid);
     }
 
+    inline
+    bool
+    AppDecorator::isWindowHidden() const noexcept {
+      return m_hidden.load(std::memory_order_acquire);
+    }
+
+    inline
+    void
+    AppDecorator::setWindowHidden(bool hidden) noexcept {
+      m_hidden.store(hidden, std::memory_order_release);
+    }
+
     inline
     utils::Uuid
     AppDecorator::createTexture(const utils::Uuid& /*win*/,
@@ -0,0 +1,386 @@
+
+# include "AppWindow.hh"
+# include <chrono>
+
+namespace sdl {
+  namespace app {
+
+    AppWindow::AppWindow(const std::string& name,
+                         const std::string& title,
+                         const utils::Sizei& size,
+                         bool resizable,
+                         const utils::Sizef& centralSize,
+                         core::engine::EngineShPtr engine,
+                         const core::engine::Palette& palette):
+      core::engine::EngineObject(name),
+
+      m_title(title),
+      m_palette(palette),
+
+      m_window(),
+      m_cachedSize(utils::Boxf::fromSize(size, true)),
+
+      m_engine(nullptr),
+      m_layout(nullptr),
+
+      m_menuBar(nullptr),
+      m_topArea(nullptr),
+      m_leftArea(nullptr),
+      m_centralWidget(nullptr),
+      m_rightArea(nullptr),
+      m_bottomArea(nullptr),
+      m_statusBar(nullptr),
+      m_docks(),
+
+      m_closeRequested(false),
+
+      m_locker()
+    {
+      setService("window");
+
+      // Check degenerate cases.
+      if (engine == nullptr) {
+        error(
+          std::string("Could not create window \"") + title + "\"",
+          std::string("Invalid null engine")
+        );
+      }
+
+      // Create the window and its canvas.
+      m_window = engine->createWindow(size, resizable, m_title);
+      if (!m_window.valid()) {
+        error(std::string("Could not create window with size " + size.toString()));
+      }
+
+      const utils::Uuid canvas = engine->createTexture(m_window, size.toType<float>(), core::engine::Palette::ColorRole::Background);
+      if (!canvas.valid()) {
+        engine->destroyWindow(m_window);
+        error(std::string("Could not create window's canvas with size " + size.toString()));
+      }
+
+      // The decorator takes ownership of the window and of the canvas.
+      m_engine = std::make_shared<AppDecorator>(engine, canvas, m_palette, m_window);
+
+      m_layout = std::make_shared<MainWindowLayout>(5.0f, centralSize);
+    }
+
+    AppWindow::~AppWindow() {
+      // Release the widgets before the decorator as they may still hold some
+      // textures created for this window. Dock widgets are released by their
+      // tab widget.
+      if (m_menuBar != nullptr) {
+        delete m_menuBar;
+      }
+      if (m_topArea != nullptr) {
+        delete m_topArea;
+      }
+      if (m_leftArea != nullptr) {
+        delete m_leftArea;
+      }
+      if (m_centralWidget != nullptr) {
+        delete m_centralWidget;
+      }
+      if (m_rightArea != nullptr) {
+        delete m_rightArea;
+      }
+      if (m_bottomArea != nullptr) {
+        delete m_bottomArea;
+      }
+      if (m_statusBar != nullptr) {
+        delete m_statusBar;
+      }
+    }
+
+    void
+    AppWindow::setEventsQueue(core::engine::EventsQueue* queue) noexcept {
+      // Use the base handler to register `this` to the provided `queue`.
+      core::engine::EngineObject::setEventsQueue(queue);
+
+      // Register the layout and the widgets to the same queue.
+      registerToSameQueue(m_layout.get());
+
+      const std::vector<core::SdlWidget*> widgets = getTopLevelWidgets();
+      for (unsigned id = 0u ; id < widgets.size() ; ++id) {
+        registerToSameQueue(widgets[id]);
+      }
+
+      for (unsigned id = 0u ; id < m_docks.size() ; ++id) {
+        registerToSameQueue(m_docks[id].widget);
+      }
+
+      // Provide the size of the window to the layout.
+      invalidate();
+    }
+
+    void
+    AppWindow::setMenuBar(core::SdlWidget* item) {
+      const std::lock_guard guard(m_locker);
+
+      shareDataWithWidget(item);
+      m_layout->setMenuBar(item);
+
+      if (m_menuBar != nullptr) {
+        delete m_menuBar;
+      }
+      m_menuBar = item;
+    }
+
+    void
+    AppWindow::setCentralWidget(core::SdlWidget* item) {
+      const std::lock_guard guard(m_locker);
+
+      shareDataWithWidget(item);
+      m_layout->setCentralWidget(item);
+
+      if (m_centralWidget != nullptr) {
+        delete m_centralWidget;
+      }
+      m_centralWidget = item;
+    }
+
+    void
+    AppWindow::setStatusBar(core::SdlWidget* item) {
+      const std::lock_guard guard(m_locker);
+
+      shareDataWithWidget(item);
+      m_layout->setStatusBar(item);
+
+      if (m_statusBar != nullptr) {
+        delete m_statusBar;
+      }
+      m_statusBar = item;
+    }
+
+    void
+    AppWindow::addDockWidget(core::SdlWidget* item,
+                             const DockWidgetArea& area,
+                             const std::string& title)
+    {
+      const std::lock_guard guard(m_locker);
+
+      shareDataWithWidget(item);
+
+      // Insert the widget in the tab widget of the area and make sure that it
+      // is visible so that it gets some space in the layout.
+      graphic::TabWidget* tab = createTabForArea(area);
+
+      tab->insertTab(tab->getTabsCount(), item, title);
+      tab->setVisible(true);
+
+      m_docks.push_back(Dock{item, area});
+
+      invalidate();
+    }
+
+    void
+    AppWindow::removeDockWidget(core::SdlWidget* item) {
+      const std::lock_guard guard(m_locker);
+
+      std::vector<Dock>::iterator it = m_docks.begin();
+      while (it != m_docks.end() && it->widget != item) {
+        ++it;
+      }
+
+      if (it == m_docks.end()) {
+        error(
+          std::string("Could not remove dock widget \"") + (item == nullptr ? std::string("null") : item->getName()) + "\" from window",
+          std::string("No such widget")
+        );
+      }
+
+      graphic::TabWidget* tab = getTabFromArea(it->area);
+      if (tab == nullptr) {
+        error(
+          std::string("Could not remove dock widget \"") + item->getName() + "\" from window",
+          std::string("Invalid tab widget")
+        );
+      }
+
+      tab->removeTab(item);
+      m_docks.erase(it);
+
+      // Hide the tab widget if needed.
+      if (tab->getTabsCount() == 0) {
+        tab->setVisible(false);
+        invalidate();
+      }
+    }
+
+    graphic::TabWidget*
+    AppWindow::createTabForArea(const DockWidgetArea& area) {
+      // Check whether the tab widget for this area already exists.
+      graphic::TabWidget* tab = getTabFromArea(area);
+      if (tab != nullptr) {
+        return tab;
+      }
+
+      tab = new graphic::TabWidget(
+        getName() + "_" + areaToName(area) + "_tabwidget",
+        nullptr,
+        graphic::TabWidget::TabPosition::North
+      );
+      shareDataWithWidget(tab);
+
+      // The tab widget is hidden until some tabs are inserted.
+      tab->setVisible(false);
+
+      switch (area) {
+        case DockWidgetArea::TopArea:
+          m_topArea = tab;
+          break;
+        case DockWidgetArea::LeftArea:
+          m_leftArea = tab;
+          break;
+        case DockWidgetArea::RightArea:
+          m_rightArea = tab;
+          break;
+        case DockWidgetArea::BottomArea:
+        default:
+          m_bottomArea = tab;
+          break;
+      }
+
+      m_layout->addDockWidget(tab, area);
+
+      return tab;
+    }
+
+    std::vector<core::SdlWidget*>
+    AppWindow::getTopLevelWidgets() const {
+      // The widgets are listed in the order in which they are drawn.
+      std::vector<core::SdlWidget*> widgets;
+
+      if (m_menuBar != nullptr) {
+        widgets.push_back(m_menuBar);
+      }
+      if (m_topArea != nullptr) {
+        widgets.push_back(m_topArea);
+      }
+      if (m_leftArea != nullptr) {
+        widgets.push_back(m_leftArea);
+      }
+      if (m_centralWidget != nullptr) {
+        widgets.push_back(m_centralWidget);
+      }
+      if (m_rightArea != nullptr) {
+        widgets.push_back(m_rightArea);
+      }
+      if (m_bottomArea != nullptr) {
+        widgets.push_back(m_bottomArea);
+      }
+      if (m_statusBar != nullptr) {
+        widgets.push_back(m_statusBar);
+      }
+
+      return widgets;
+    }
+
+    float
+    AppWindow::render(Tracer* tracer) {
+      const Tracer::Scope scope(tracer, "main", getName());
+      auto start = std::chrono::steady_clock::now();
+
+      {
+        const std::lock_guard guard(m_locker);
+
+        m_engine->clearWindow(m_window);
+
+        const std::vector<core::SdlWidget*> widgets = getTopLevelWidgets();
+
+        for (unsigned id = 0u ; id < widgets.size() ; ++id) {
+          core::SdlWidget* widget = widgets[id];
+          if (!widget->isVisible()) {
+            continue;
+          }
+
+          withSafetyNet(
+            [this, widget]() {
+              m_engine->drawWidget(*widget);
+            },
+            std::string("drawWidget(") + widget->getName() + ")"
+          );
+        }
+
+        m_engine->renderWindow(m_window);
+      }
+
+      auto end = std::chrono::steady_clock::now();
+      return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() / 1000.0f;
+    }
+
+    bool
+    AppWindow::geometryUpdateEvent(const core::engine::Event& e) {
+      const std::lock_guard guard(m_locker);
+
+      postEvent(std::make_shared<core::engine::ResizeEvent>(m_cachedSize, m_layout->getRenderingArea(), m_layout.get()));
+
+      return core::engine::EngineObject::geometryUpdateEvent(e);
+    }
+
+    bool
+    AppWindow::windowLeaveEvent(const core::engine::WindowEvent& e) {
+      if (!(e.getWindID() == m_window)) {
+        return core::engine::EngineObject::windowLeaveEvent(e);
+      }
+
+      // As for the main window, make sure that no widget stays highlighted when
+      // the mouse leaves the window.
+      const std::lock_guard guard(m_locker);
+
+      const core::engine::FocusEvent::Reason focus = core::engine::FocusEvent::Reason::HoverFocus;
+      const std::vector<core::SdlWidget*> widgets = getTopLevelWidgets();
+
+      for (unsigned id = 0u ; id < widgets.size() ; ++id) {
+        postEvent(core::engine::FocusEvent::createFocusOutEvent(focus, false, widgets[id]));
+      }
+
+      return core::engine::EngineObject::windowLeaveEvent(e);
+    }
+
+    bool
+    AppWindow::windowResizeEvent(const core::engine::WindowEvent& e) {
+      // The events of all windows are dispatched to every listener so we need
+      // to only consider the ones related to this window.
+      if (!(e.getWindID() == m_window)) {
+        return core::engine::EngineObject::windowResizeEvent(e);
+      }
+
+      const utils::Sizef size = e.getSize();
+
+      const std::lock_guard guard(m_locker);
+
+      if (size == m_cachedSize.toSize()) {
+        return core::engine::EngineObject::windowResizeEvent(e);
+      }
+
+      // Create a new canvas with the required dimensions: this also updates
+      // the viewport of the window.
+      m_engine->resizeCanvas(size);
+
+      m_cachedSize = utils::Boxf::fromSize(size);
+
+      invalidate();
+
+      return core::engine::EngineObject::windowResizeEvent(e);
+    }
+
+    bool
+    AppWindow::windowShowEvent(const core::engine::WindowEvent& e) {
+      if (e.getWindID() == m_window) {
+        m_engine->setWindowHidden(false);
+      }
+
+      return core::engine::EngineObject::windowShowEvent(e);
+    }
+
+    bool
+    AppWindow::windowHideEvent(const core::engine::WindowEvent& e) {
+      if (e.getWindID() == m_window) {
+        m_engine->setWindowHidden(true);
+      }
+
+      return core::engine::EngineObject::windowHideEvent(e);
+    }
+
+  }
+}
@@ -0,0 +1,294 @@
+#ifndef    APP_WINDOW_HH
+# define   APP_WINDOW_HH
+
+# include <mutex>
+# include <atomic>
+# include <memory>
+# include <string>
+# include <vector>
+# include <maths_utils/Box.hh>
+# include <maths_utils/Size.hh>
+# include <sdl_core/SdlWidget.hh>
+# include <sdl_engine/Engine.hh>
+# include <sdl_engine/Palette.hh>
+# include <sdl_engine/EngineObject.hh>
+# include <sdl_graphic/TabWidget.hh>
+# include "AppDecorator.hh"
+# include "MainWindowLayout.hh"
+# include "Tracer.hh"
+
+namespace sdl {
+  namespace app {
+
+    /**
+     * @brief - Describes an additional window of an application. Each window has its
+     *          own canvas, decorator and layout but shares the engine, the events pump
+     *          and the rendering loop of the application which created it.
+     *          Widgets inserted in a window are owned by it and use its decorator so
+     *          that their textures are created for the renderer of the window. They
+     *          ignore the events related to other windows.
+     *          When the user closes the window, it is closed by the application on
+     *          the next frame.
+     */
+    class AppWindow: public core::engine::EngineObject {
+      public:
+
+        /**
+         * @brief - Creates a new window using the provided `engine`. Note that the
+         *          window is not registered to any events queue: this is handled by
+         *          the application when the window is opened.
+         * @param name - the name of the window.
+         * @param title - the title of the window.
+         * @param size - the initial size of the window.
+         * @param resizable - whether the window can be resized.
+         * @param centralSize - the percentage of the area occupied by the central
+         *                      widget along each axis.
+         * @param engine - the engine to use to create the window. It should not be
+         *                 an `AppDecorator` as it would redirect the creation of the
+         *                 textures to another window.
+         * @param palette - the palette to use to clear the canvas of the window.
+         */
+        AppWindow(const std::string& name,
+                  const std::string& title,
+                  const utils::Sizei& size,
+                  bool resizable,
+                  const utils::Sizef& centralSize,
+                  core::engine::EngineShPtr engine,
+                  const core::engine::Palette& palette);
+
+        virtual ~AppWindow();
+
+        const std::string&
+        getTitle() const noexcept;
+
+        /**
+         * @brief - Returns the identifier of the window as provided by the engine.
+         *          It can be used to match the events related to this window.
+         * @return - the identifier of the window.
+         */
+        const utils::Uuid&
+        getUuid() const noexcept;
+
+        void
+        setIcon(const std::string& icon);
+
+        /**
+         * @brief - Whether this window is hidden or minimized. Such a window is
+         *          not rendered by the application.
+         * @return - `true` if the window is not visible.
+         */
+        bool
+        isHidden() const noexcept;
+
+        /**
+         * @brief - Whether the user or the application asked to close this window.
+         *          The application stops rendering such a window and releases it.
+         * @return - `true` if the window should be closed.
+         */
+        bool
+        isCloseRequested() const noexcept;
+
+        /**
+         * @brief - Marks this window as closed so that the application releases
+         *          it on the next frame. This can be called from any thread.
+         */
+        void
+        requestClose() noexcept;
+
+        /**
+         * @brief - Assigns the tracer used to record the computations of the layout
+         *          of this window.
+         * @param tracer - the tracer to use, may be null.
+         */
+        void
+        setTracer(TracerShPtr tracer) noexcept;
+
+        /**
+         * @brief - Assigns the sink used by the layout of this window to write its
+         *          messages.
+         * @param sink - the sink to use, may be null.
+         */
+        void
+        setLogSink(AsyncLogSinkShPtr sink);
+
+        /**
+         * @brief - Reimplementation of the `EngineObject` method so that the layout
+         *          and the widgets of this window are registered to the same queue.
+         * @param queue - the queue to register.
+         */
+        void
+        setEventsQueue(core::engine::EventsQueue* queue) noexcept override;
+
+        void
+        setMenuBar(core::SdlWidget* item);
+
+        void
+        setCentralWidget(core::SdlWidget* item);
+
+        void
+        setStatusBar(core::SdlWidget* item);
+
+        /**
+         * @brief - Inserts the input `item` in the specified `area`. As for the main
+         *          window of the application, dock widgets are grouped in a tab
+         *          widget for each area which is created when the first widget is
+         *          inserted in it.
+         * @param item - the widget to insert.
+         * @param area - the area where the widget should be inserted.
+         * @param title - the title of the tab holding the widget.
+         */
+        void
+        addDockWidget(core::SdlWidget* item,
+                      const DockWidgetArea& area,
+                      const std::string& title = std::string());
+
+        /**
+         * @brief - Removes the input dock widget from its tab widget. The tab widget
+         *          is hidden if it does not hold any widget anymore. An error is
+         *          raised if the widget is not a dock widget of this window.
+         * @param item - the widget to remove.
+         */
+        void
+        removeDockWidget(core::SdlWidget* item);
+
+        /**
+         * @brief - Draws the visible widgets of this window on its canvas and
+         *          presents it on screen. Must be called from the main thread.
+         * @param tracer - the tracer to use to record the rendering, may be null.
+         * @return - the time it took to render the window in milliseconds.
+         */
+        float
+        render(Tracer* tracer);
+
+      protected:
+
+        bool
+        geometryUpdateEvent(const core::engine::Event& e) override;
+
+        bool
+        windowLeaveEvent(const core::engine::WindowEvent& e) override;
+
+        bool
+        windowResizeEvent(const core::engine::WindowEvent& e) override;
+
+        /**
+         * @brief - Reimplementation of the `EngineObject` methods to keep track of
+         *          the visibility of the window so that the rendering is suspended
+         *          while it is hidden or minimized.
+         * @param e - the event to be interpreted.
+         * @return - `true` if the event was recognized, `false` otherwise.
+         */
+        bool
+        windowShowEvent(const core::engine::WindowEvent& e) override;
+
+        bool
+        windowHideEvent(const core::engine::WindowEvent& e) override;
+
+        bool
+        quitEvent(const core::engine::QuitEvent& e) override;
+
+        /**
+         * @brief - Reimplementation of the `EngineObject` method so that the widgets
+         *          of this window ignore the events related to other windows: the
+         *          events of all windows are dispatched to every listener.
+         * @param watched - the widget for which the event is filtered.
+         * @param e - the event to filter.
+         * @return - `true` if the event should not be transmitted to the widget.
+         */
+        bool
+        filterEvent(core::engine::EngineObject* watched,
+                    core::engine::EventShPtr e) override;
+
+      private:
+
+        /**
+         * @brief - Sets up the input `widget` so that it can be displayed in
+         *          this window: it is registered to the same queue and uses
+         *          the decorator of the window.
+         * @param widget - the widget to set up.
+         */
+        void
+        shareDataWithWidget(core::SdlWidget* widget);
+
+        void
+        invalidate();
+
+        /**
+         * @brief - Returns the tab widget holding the dock widgets of the input
+         *          `area`. An error is raised if the area is not a dock area.
+         * @param area - the area for which the tab widget should be retrieved.
+         * @return - the tab widget of the area, which may be null.
+         */
+        graphic::TabWidget*
+        getTabFromArea(const DockWidgetArea& area);
+
+        /**
+         * @brief - Returns the tab widget holding the dock widgets of the input
+         *          `area`, creating it and inserting it in the layout if needed.
+         * @param area - the area for which the tab widget should be created.
+         * @return - the tab widget of the area.
+         */
+        graphic::TabWidget*
+        createTabForArea(const DockWidgetArea& area);
+
+        /**
+         * @brief - Returns the top-level widgets of this window in the order in
+         *          which they are drawn. Dock widgets are represented by their
+         *          tab widget. Assumes that the `m_locker` is already acquired.
+         * @return - the top-level widgets which are not null.
+         */
+        std::vector<core::SdlWidget*>
+        getTopLevelWidgets() const;
+
+      private:
+
+        /**
+         * @brief - Describes a dock widget inserted in this window along with the
+         *          area in which it is displayed.
+         */
+        struct Dock {
+          core::SdlWidget* widget;
+          DockWidgetArea area;
+        };
+
+        std::string m_title;
+        core::engine::Palette m_palette;
+
+        utils::Uuid m_window;
+        utils::Boxf m_cachedSize;
+
+        AppDecoratorShPtr m_engine;
+        MainWindowLayoutShPtr m_layout;
+
+        /**
+         * @brief - The widgets displayed in this window. Dock widgets are held by
+         *          the tab widget of their area.
+         */
+        core::SdlWidget* m_menuBar;
+        graphic::TabWidget* m_topArea;
+        graphic::TabWidget* m_leftArea;
+        core::SdlWidget* m_centralWidget;
+        graphic::TabWidget* m_rightArea;
+        graphic::TabWidget* m_bottomArea;
+        core::SdlWidget* m_statusBar;
+        std::vector<Dock> m_docks;
+
+        /**
+         * @brief - Set when the window is closed by the user or the application.
+         */
+        std::atomic<bool> m_closeRequested;
+
+        /**
+         * @brief - Protects the widgets and the canvas of this window from
+         *          concurrent accesses from the rendering and events threads.
+         */
+        std::recursive_mutex m_locker;
+    };
+
+    using AppWindowShPtr = std::shared_ptr<AppWindow>;
+  }
+}
+
+# include "AppWindow.hxx"
+
+#endif    /* APP_WINDOW_HH */
@@ -0,0 +1,131 @@
+#ifndef    APP_WINDOW_HXX
+# define   APP_WINDOW_HXX
+
+# include "AppWindow.hh"
+
+namespace sdl {
+  namespace app {
+
+    inline
+    const std::string&
+    AppWindow::getTitle() const noexcept {
+      return m_title;
+    }
+
+    inline
+    const utils::Uuid&
+    AppWindow::getUuid() const noexcept {
+      return m_window;
+    }
+
+    inline
+    void
+    AppWindow::setIcon(const std::string& icon) {
+      m_engine->setWindowIcon(m_window, icon);
+    }
+
+    inline
+    bool
+    AppWindow::isHidden() const noexcept {
+      return m_engine->isWindowHidden();
+    }
+
+    inline
+    bool
+    AppWindow::isCloseRequested() const noexcept {
+      return m_closeRequested.load(std::memory_order_acquire);
+    }
+
+    inline
+    void
+    AppWindow::requestClose() noexcept {
+      m_closeRequested.store(true, std::memory_order_release);
+    }
+
+    inline
+    void
+    AppWindow::setTracer(TracerShPtr tracer) noexcept {
+      m_layout->setTracer(tracer);
+    }
+
+    inline
+    void
+    AppWindow::setLogSink(AsyncLogSinkShPtr sink) {
+      m_layout->setLogSink(sink);
+    }
+
+    inline
+    void
+    AppWindow::shareDataWithWidget(core::SdlWidget* widget) {
+      // Check degenerate cases.
+      if (widget == nullptr) {
+        error(std::string("Cannot add null widget"));
+      }
+
+      registerToSameQueue(widget);
+      widget->setEngine(m_engine);
+
+      // Prevent the widget from reacting to the events of other windows.
+      widget->installEventFilter(this);
+    }
+
+    inline
+    bool
+    AppWindow::filterEvent(core::engine::EngineObject* watched,
+                           core::engine::EventShPtr e)
+    {
+      // Events which are not related to a window are always transmitted.
+      if (e != nullptr && e->getWindID().valid() && !(e->getWindID() == m_window)) {
+        return true;
+      }
+
+      return core::engine::EngineObject::filterEvent(watched, e);
+    }
+
+    inline
+    bool
+    AppWindow::quitEvent(const core::engine::QuitEvent& e) {
+      // The application is notified when any window is closed: only consider
+      // the events related to this window.
+      if (e.getWindID() == m_window) {
+        requestClose();
+      }
+
+      return core::engine::EngineObject::quitEvent(e);
+    }
+
+    inline
+    graphic::TabWidget*
+    AppWindow::getTabFromArea(const DockWidgetArea& area) {
+      switch (area) {
+        case DockWidgetArea::TopArea:
+          return m_topArea;
+        case DockWidgetArea::LeftArea:
+          return m_leftArea;
+        case DockWidgetArea::RightArea:
+          return m_rightArea;
+        case DockWidgetArea::BottomArea:
+          return m_bottomArea;
+        default:
+          break;
+      }
+
+      error(
+        std::string("Could not retrieve tab widget from window for area \"") + areaToName(area) + "\"",
+        std::string("Invalid area")
+      );
+
+      // Silent the compiler.
+      return nullptr;
+    }
+
+    inline
+    void
+    AppWindow::invalidate() {
+      postEvent(std::make_shared<core::engine::Event>(core::engine::Event::Type::GeometryUpdate, this));
+    }
+
+  }
+}
+
+#endif    /* APP_WINDOW_HXX */
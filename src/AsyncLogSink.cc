@@ -0,0 +1,309 @@
+
+# include "AsyncLogSink.hh"
+# include <chrono>
+# include <cstring>
+# include <algorithm>
+
+namespace sdl {
+  namespace app {
+
+    AsyncLogSink::AsyncLogSink(std::size_t capacity):
+      utils::CoreObject(std::string("async_log_sink")),
+
+      m_capacity(capacity),
+      m_slots(),
+      m_mask(0u),
+
+      m_head(0u),
+      m_tail(0u),
+
+      m_enabled(false),
+      m_producers(0u),
+
+      m_dropped(0u),
+      m_truncated(0u),
+      m_reportedDrops(0u),
+
+      m_sourcesLocker(),
+      m_sources(),
+
+      m_locker(),
+      m_wakeup(),
+      m_running(false),
+      m_writer()
+    {
+      setService("log");
+    }
+
+    void
+    AsyncLogSink::start() {
+      const std::lock_guard guard(m_locker);
+
+      if (m_running) {
+        return;
+      }
+
+      // Allocate the ring the first time the sink is started. Round the capacity
+      // to a power of two so that positions can be mapped to slots with a mask.
+      if (m_slots == nullptr) {
+        std::uint64_t size = 1u;
+        while (size < std::max<std::size_t>(m_capacity, 2u)) {
+          size <<= 1u;
+        }
+
+        m_slots = std::make_unique<Slot[]>(size);
+        m_mask = size - 1u;
+
+        for (std::uint64_t id = 0u ; id < size ; ++id) {
+          m_slots[id].sequence.store(id, std::memory_order_relaxed);
+        }
+      }
+
+      m_running = true;
+      m_writer = std::thread(&AsyncLogSink::writeMessages, this);
+
+      m_enabled.store(true, std::memory_order_release);
+    }
+
+    void
+    AsyncLogSink::stop() {
+      {
+        const std::lock_guard guard(m_locker);
+
+        if (!m_running) {
+          return;
+        }
+
+        // Refuse new messages: the producers fall back to synchronous logging.
+        m_enabled.store(false);
+        m_running = false;
+      }
+
+      m_wakeup.notify_all();
+
+      if (m_writer.joinable()) {
+        m_writer.join();
+      }
+    }
+
+    AsyncLogSink::Source
+    AsyncLogSink::registerSource(const std::string& name,
+                                 const std::string& service)
+    {
+      const std::lock_guard guard(m_sourcesLocker);
+
+      for (unsigned id = 0u ; id < m_sources.size() ; ++id) {
+        if (m_sources[id]->matches(name, service)) {
+          return id;
+        }
+      }
+
+      m_sources.push_back(std::make_unique<Proxy>(name, service));
+
+      return static_cast<Source>(m_sources.size() - 1u);
+    }
+
+    void
+    AsyncLogSink::Proxy::write(Level level,
+                               const std::string& message) const
+    {
+      switch (level) {
+        case Level::Warning:
+          warn(message);
+          break;
+        case Level::Notice:
+          notice(message);
+          break;
+        case Level::Verbose:
+        default:
+          verbose(message);
+          break;
+      }
+    }
+
+    AsyncLogSink::Slot*
+    AsyncLogSink::reserve(std::uint64_t& pos) noexcept {
+      // This is the bounded queue described by D. Vyukov where the sequence of
+      // each slot tells whether it is available for writing.
+      pos = m_head.load(std::memory_order_relaxed);
+
+      while (true) {
+        Slot& candidate = m_slots[pos & m_mask];
+        const std::uint64_t seq = candidate.sequence.load(std::memory_order_acquire);
+        const std::int64_t diff = static_cast<std::int64_t>(seq) - static_cast<std::int64_t>(pos);
+
+        if (diff == 0) {
+          if (m_head.compare_exchange_weak(pos, pos + 1u, std::memory_order_relaxed)) {
+            return &candidate;
+          }
+        }
+        else if (diff < 0) {
+          // The ring is full: the background thread did not catch up yet.
+          m_dropped.fetch_add(1u, std::memory_order_relaxed);
+          return nullptr;
+        }
+        else {
+          pos = m_head.load(std::memory_order_relaxed);
+        }
+      }
+    }
+
+    void
+    AsyncLogSink::encodeText(Slot& slot,
+                             Argument& arg,
+                             std::string_view text) noexcept
+    {
+      arg.type = Argument::Type::Text;
+
+      // The text area is full: point to the terminating character of the last
+      // string so that the argument is empty.
+      if (slot.used >= TextSize) {
+        arg.offset = TextSize - 1u;
+        m_truncated.fetch_add(1u, std::memory_order_relaxed);
+        return;
+      }
+
+      const std::size_t length = std::min(text.size(), TextSize - slot.used - 1u);
+      if (length < text.size()) {
+        m_truncated.fetch_add(1u, std::memory_order_relaxed);
+      }
+
+      arg.offset = slot.used;
+      std::memcpy(slot.text + slot.used, text.data(), length);
+      slot.text[slot.used + length] = '\0';
+
+      slot.used += length + 1u;
+    }
+
+    std::string
+    AsyncLogSink::format(const Slot& slot) {
+      std::string out;
+      unsigned next = 0u;
+
+      // Replace each placeholder with the next argument: the extra placeholders
+      // are kept as is.
+      for (const char* c = slot.format ; *c != '\0' ; ++c) {
+        if (c[0] != '{' || c[1] != '}' || next >= slot.count) {
+          out += *c;
+          continue;
+        }
+
+        const Argument& arg = slot.args[next];
+        ++next;
+        ++c;
+
+        switch (arg.type) {
+          case Argument::Type::Signed:
+            out += std::to_string(arg.integer);
+            break;
+          case Argument::Type::Unsigned:
+            out += std::to_string(arg.natural);
+            break;
+          case Argument::Type::Floating:
+            out += std::to_string(arg.floating);
+            break;
+          case Argument::Type::Text:
+          default:
+            out += slot.text + arg.offset;
+            break;
+        }
+      }
+
+      return out;
+    }
+
+    void
+    AsyncLogSink::write(Source source,
+                        Level level,
+                        const std::string& message)
+    {
+      // Sources are never removed so the proxy can be used without the lock.
+      const Proxy* proxy = nullptr;
+      {
+        const std::lock_guard guard(m_sourcesLocker);
+        if (source < m_sources.size()) {
+          proxy = m_sources[source].get();
+        }
+      }
+
+      if (proxy == nullptr) {
+        warn("Received message from unknown source " + std::to_string(source) + ": " + message);
+        return;
+      }
+
+      proxy->write(level, message);
+    }
+
+    void
+    AsyncLogSink::writeMessages() {
+      // Interval at which the background thread wakes up to write the pending
+      // messages. Producers never notify the thread so that posting a message
+      // does not involve any system call.
+      const std::chrono::milliseconds interval(10);
+
+      bool running = true;
+
+      while (running) {
+        drain();
+        reportDrops();
+
+        std::unique_lock guard(m_locker);
+        m_wakeup.wait_for(guard, interval, [this]() { return !m_running; });
+
+        running = m_running;
+      }
+
+      // Producers which saw the sink enabled may still be publishing: wait for
+      // them so that no message is left in the ring after the last drain. New
+      // producers write their messages themselves.
+      while (m_producers.load() > 0u) {
+        std::this_thread::yield();
+      }
+
+      // Write the messages posted before the sink was stopped.
+      drain();
+      reportDrops();
+    }
+
+    unsigned
+    AsyncLogSink::drain() {
+      unsigned count = 0u;
+
+      while (true) {
+        Slot& slot = m_slots[m_tail & m_mask];
+        if (slot.sequence.load(std::memory_order_acquire) != m_tail + 1u) {
+          // No more message available.
+          return count;
+        }
+
+        const std::string message = format(slot);
+        const Source source = slot.source;
+        const Level level = slot.level;
+
+        // Release the slot before writing the message so that producers can
+        // use it again as soon as possible.
+        slot.sequence.store(m_tail + m_mask + 1u, std::memory_order_release);
+        ++m_tail;
+        ++count;
+
+        write(source, level, message);
+      }
+    }
+
+    void
+    AsyncLogSink::reportDrops() {
+      const std::uint64_t dropped = m_dropped.load(std::memory_order_relaxed);
+      if (dropped == m_reportedDrops) {
+        return;
+      }
+
+      warn(
+        "Dropped " + std::to_string(dropped - m_reportedDrops) + " message(s) " +
+        "(" + std::to_string(dropped) + " in total) as the sink is full"
+      );
+
+      m_reportedDrops = dropped;
+    }
+
+  }
+}
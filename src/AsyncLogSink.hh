@@ -0,0 +1,315 @@
+#ifndef    ASYNC_LOG_SINK_HH
+# define   ASYNC_LOG_SINK_HH
+
+# include <mutex>
+# include <atomic>
+# include <memory>
+# include <string>
+# include <thread>
+# include <vector>
+# include <cstdint>
+# include <string_view>
+# include <condition_variable>
+# include <core_utils/CoreObject.hh>
+
+namespace sdl {
+  namespace app {
+
+    /**
+     * @brief - Allows to move the cost of writing log messages out of the
+     *          rendering thread. Producers post a format string along with
+     *          its arguments which are copied into a ring of slots, and the
+     *          messages are formatted and written by a background thread.
+     *          Posting a message never blocks nor allocates: when the ring is
+     *          full the message is dropped and counted, and a summary of the
+     *          dropped messages is written as soon as the background thread
+     *          catches up.
+     *          Each message is written on behalf of the object which emitted
+     *          it so that it keeps its name and service. When the sink is not
+     *          started messages are formatted and written synchronously: an
+     *          unstarted sink is cheap as the ring is only allocated when the
+     *          sink is started for the first time.
+     */
+    class AsyncLogSink: public utils::CoreObject {
+      public:
+
+        /**
+         * @brief - The severity of a message, mapped to the corresponding
+         *          logging method when the message is written.
+         */
+        enum class Level {
+          Verbose,
+          Notice,
+          Warning
+        };
+
+        /**
+         * @brief - Identifies an object emitting messages through the sink.
+         */
+        using Source = unsigned;
+
+        /**
+         * @brief - Creates a new sink which is not started. The number of slots
+         *          is rounded up to the next power of two.
+         * @param capacity - the number of messages which can be pending before
+         *                   new ones are dropped.
+         */
+        explicit
+        AsyncLogSink(std::size_t capacity = 512u);
+
+        virtual ~AsyncLogSink();
+
+        /**
+         * @brief - Starts the background thread: from now on messages posted
+         *          to the sink are accepted. Nothing happens if the sink is
+         *          already started.
+         */
+        void
+        start();
+
+        /**
+         * @brief - Stops the background thread after writing all the pending
+         *          messages. Messages posted afterwards are written directly by
+         *          the calling thread.
+         */
+        void
+        stop();
+
+        bool
+        isEnabled() const noexcept;
+
+        /**
+         * @brief - Registers an object emitting messages through this sink. The
+         *          messages of this source are written with the input name and
+         *          service. Registering the same name and service twice returns
+         *          the same source. This method can be called from any thread.
+         * @param name - the name of the emitting object.
+         * @param service - the service of the emitting object.
+         * @return - the identifier to use when posting messages.
+         */
+        Source
+        registerSource(const std::string& name,
+                       const std::string& service);
+
+        /**
+         * @brief - Writes a new message on behalf of the `source`. Each `{}` in
+         *          the `format` is replaced by the next argument, which can be a
+         *          number or a string.
+         *          When the sink is started the arguments are copied in a slot
+         *          and the formatting happens in the background thread: this is
+         *          lock-free and never allocates. Strings longer than the space
+         *          available in a slot are truncated. Otherwise the message is
+         *          formatted and written right away.
+         * @param source - the object emitting the message.
+         * @param level - the severity of the message.
+         * @param format - the format of the message. It should be a literal as
+         *                 it is only read when the message is written.
+         * @param args - the arguments of the message.
+         */
+        template <typename... Args>
+        void
+        log(Source source,
+            Level level,
+            const char* format,
+            const Args&... args);
+
+        std::uint64_t
+        getDroppedCount() const noexcept;
+
+        std::uint64_t
+        getTruncatedCount() const noexcept;
+
+      private:
+
+        /**
+         * @brief - Maximum number of arguments of a message and size of the area
+         *          of a slot where the string arguments are copied.
+         */
+        static constexpr std::size_t MaxArgs = 6u;
+        static constexpr std::size_t TextSize = 160u;
+
+        /**
+         * @brief - An argument of a message. Strings are copied in the text area
+         *          of the slot, starting at `offset`.
+         */
+        struct Argument {
+          enum class Type {
+            Signed,
+            Unsigned,
+            Floating,
+            Text
+          };
+
+          Type type;
+          union {
+            std::int64_t integer;
+            std::uint64_t natural;
+            double floating;
+            std::size_t offset;
+          };
+        };
+
+        /**
+         * @brief - A slot of the ring. The `sequence` allows producers and the
+         *          consumer to agree on the ownership of the slot without any
+         *          lock: a slot at position `p` is free when its sequence is `p`
+         *          and holds a message when its sequence is `p + 1`.
+         */
+        struct Slot {
+          std::atomic<std::uint64_t> sequence;
+          Source source;
+          Level level;
+          const char* format;
+          unsigned count;
+          Argument args[MaxArgs];
+          std::size_t used;
+          char text[TextSize];
+        };
+
+        /**
+         * @brief - Writes the messages on behalf of a registered source: it has
+         *          the same name and service as the object emitting them.
+         */
+        class Proxy: public utils::CoreObject {
+          public:
+
+            Proxy(const std::string& name,
+                  const std::string& service);
+
+            bool
+            matches(const std::string& name,
+                    const std::string& service) const noexcept;
+
+            void
+            write(Level level,
+                  const std::string& message) const;
+
+          private:
+
+            std::string m_service;
+        };
+
+        /**
+         * @brief - Reserves the next slot of the ring.
+         * @return - the reserved slot along with its position or `null` if the
+         *           ring is full.
+         */
+        Slot*
+        reserve(std::uint64_t& pos) noexcept;
+
+        /**
+         * @brief - Copies the description of a message in the input `slot`.
+         */
+        template <typename... Args>
+        void
+        fill(Slot& slot,
+             Source source,
+             Level level,
+             const char* format,
+             const Args&... args) noexcept;
+
+        /**
+         * @brief - Copies the input argument in the `slot`.
+         */
+        template <typename Arg>
+        void
+        encode(Slot& slot,
+               const Arg& arg) noexcept;
+
+        void
+        encodeText(Slot& slot,
+                   Argument& arg,
+                   std::string_view text) noexcept;
+
+        /**
+         * @brief - Builds the message described by the `slot` by substituting
+         *          its arguments in its format.
+         * @param slot - the slot to format.
+         * @return - the formatted message.
+         */
+        static
+        std::string
+        format(const Slot& slot);
+
+        /**
+         * @brief - Writes the input message on behalf of the `source`.
+         * @param source - the object which emitted the message.
+         * @param level - the severity of the message.
+         * @param message - the message to write.
+         */
+        void
+        write(Source source,
+              Level level,
+              const std::string& message);
+
+        /**
+         * @brief - Body of the background thread: writes the pending messages
+         *          until the sink is stopped.
+         */
+        void
+        writeMessages();
+
+        /**
+         * @brief - Writes all the messages currently available in the ring.
+         *          Should only be called from the background thread.
+         * @return - the number of messages written.
+         */
+        unsigned
+        drain();
+
+        /**
+         * @brief - Writes a summary of the messages dropped since the last call
+         *          to this method if any.
+         */
+        void
+        reportDrops();
+
+      private:
+
+        std::size_t m_capacity;
+        std::unique_ptr<Slot[]> m_slots;
+        std::uint64_t m_mask;
+
+        /**
+         * @brief - Position of the next slot to fill for producers and of the
+         *          next slot to read for the background thread.
+         */
+        std::atomic<std::uint64_t> m_head;
+        std::uint64_t m_tail;
+
+        /**
+         * @brief - Whether producers can post messages in the ring and number
+         *          of producers which may currently be doing so.
+         */
+        std::atomic<bool> m_enabled;
+        std::atomic<unsigned> m_producers;
+
+        std::atomic<std::uint64_t> m_dropped;
+        std::atomic<std::uint64_t> m_truncated;
+        std::uint64_t m_reportedDrops;
+
+        /**
+         * @brief - The registered sources, indexed by their identifier. Only
+         *          used when writing messages so it is protected by its own
+         *          locker.
+         */
+        std::mutex m_sourcesLocker;
+        std::vector<std::unique_ptr<Proxy>> m_sources;
+
+        /**
+         * @brief - Used to control the background thread. Producers never use
+         *          it: the thread wakes up periodically to write the messages.
+         */
+        std::mutex m_locker;
+        std::condition_variable m_wakeup;
+        bool m_running;
+        std::thread m_writer;
+    };
+
+    using AsyncLogSinkShPtr = std::shared_ptr<AsyncLogSink>;
+  }
+}
+
+# include "AsyncLogSink.hxx"
+
+#endif    /* ASYNC_LOG_SINK_HH */
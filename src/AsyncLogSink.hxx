@@ -0,0 +1,139 @@
+#ifndef    ASYNC_LOG_SINK_HXX
+# define   ASYNC_LOG_SINK_HXX
+
+# include <type_traits>
+# include "AsyncLogSink.hh"
+
+namespace sdl {
+  namespace app {
+
+    inline
+    AsyncLogSink::~AsyncLogSink() {
+      stop();
+    }
+
+    inline
+    bool
+    AsyncLogSink::isEnabled() const noexcept {
+      return m_enabled.load(std::memory_order_acquire);
+    }
+
+    template <typename... Args>
+    inline
+    void
+    AsyncLogSink::log(Source source,
+                      Level level,
+                      const char* format,
+                      const Args&... args)
+    {
+      static_assert(sizeof...(Args) <= MaxArgs, "Too many arguments for a log message");
+
+      // Register as a producer before checking whether the sink is started:
+      // when stopping, the background thread waits for the producers which
+      // may still publish a message before writing the last ones.
+      m_producers.fetch_add(1u);
+
+      if (m_enabled.load()) {
+        // The message is dropped if the ring is full.
+        std::uint64_t pos = 0u;
+        Slot* slot = reserve(pos);
+
+        if (slot != nullptr) {
+          fill(*slot, source, level, format, args...);
+
+          // Publish the message to the background thread.
+          slot->sequence.store(pos + 1u, std::memory_order_release);
+        }
+
+        m_producers.fetch_sub(1u, std::memory_order_release);
+        return;
+      }
+
+      m_producers.fetch_sub(1u, std::memory_order_release);
+
+      // The sink is not started: write the message right away.
+      Slot local;
+      fill(local, source, level, format, args...);
+
+      write(source, level, AsyncLogSink::format(local));
+    }
+
+    inline
+    std::uint64_t
+    AsyncLogSink::getDroppedCount() const noexcept {
+      return m_dropped.load(std::memory_order_relaxed);
+    }
+
+    inline
+    std::uint64_t
+    AsyncLogSink::getTruncatedCount() const noexcept {
+      return m_truncated.load(std::memory_order_relaxed);
+    }
+
+    template <typename... Args>
+    inline
+    void
+    AsyncLogSink::fill(Slot& slot,
+                       Source source,
+                       Level level,
+                       const char* format,
+                       const Args&... args) noexcept
+    {
+      slot.source = source;
+      slot.level = level;
+      slot.format = format;
+      slot.count = 0u;
+      slot.used = 0u;
+
+      (encode(slot, args), ...);
+    }
+
+    template <typename Arg>
+    inline
+    void
+    AsyncLogSink::encode(Slot& slot,
+                         const Arg& arg) noexcept
+    {
+      Argument& out = slot.args[slot.count];
+      ++slot.count;
+
+      if constexpr (std::is_floating_point_v<Arg>) {
+        out.type = Argument::Type::Floating;
+        out.floating = static_cast<double>(arg);
+      }
+      else if constexpr (std::is_integral_v<Arg> && std::is_signed_v<Arg>) {
+        out.type = Argument::Type::Signed;
+        out.integer = static_cast<std::int64_t>(arg);
+      }
+      else if constexpr (std::is_integral_v<Arg>) {
+        out.type = Argument::Type::Unsigned;
+        out.natural = static_cast<std::uint64_t>(arg);
+      }
+      else {
+        static_assert(std::is_convertible_v<const Arg&, std::string_view>, "Log arguments should be numbers or strings");
+        encodeText(slot, out, std::string_view(arg));
+      }
+    }
+
+    inline
+    AsyncLogSink::Proxy::Proxy(const std::string& name,
+                               const std::string& service):
+      utils::CoreObject(name),
+
+      m_service(service)
+    {
+      setService(m_service);
+    }
+
+    inline
+    bool
+    AsyncLogSink::Proxy::matches(const std::string& name,
+                                 const std::string& service) const noexcept
+    {
+      return getName() == name && m_service == service;
+    }
+
+  }
+}
+
+#endif    /* ASYNC_LOG_SINK_HXX */
@@ -0,0 +1,35 @@
+#ifndef    DOCK_WIDGET_HANDLE_HH
+# define   DOCK_WIDGET_HANDLE_HH
+
+# include <cstdint>
+
+namespace sdl {
+  namespace app {
+
+    /**
+     * @brief - Identifies a dock widget registered in an application. The
+     *          `index` locates the slot describing the widget while the
+     *          `generation` allows to detect handles referring to a widget
+     *          which has since been removed: the slot may be reused for a
+     *          different widget in which case its generation differs.
+     *          A generation of `0` is never attributed so that a default
+     *          handle is always invalid.
+     */
+    struct DockWidgetHandle {
+      std::uint32_t index;
+      std::uint32_t generation;
+    };
+
+    bool
+    operator==(const DockWidgetHandle& lhs,
+               const DockWidgetHandle& rhs) noexcept;
+
+    bool
+    isValid(const DockWidgetHandle& handle) noexcept;
+
+  }
+}
+
+# include "DockWidgetHandle.hxx"
+
+#endif    /* DOCK_WIDGET_HANDLE_HH */
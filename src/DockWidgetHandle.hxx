@@ -0,0 +1,26 @@
+#ifndef    DOCK_WIDGET_HANDLE_HXX
+# define   DOCK_WIDGET_HANDLE_HXX
+
+# include "DockWidgetHandle.hh"
+
+namespace sdl {
+  namespace app {
+
+    inline
+    bool
+    operator==(const DockWidgetHandle& lhs,
+               const DockWidgetHandle& rhs) noexcept
+    {
+      return lhs.index == rhs.index && lhs.generation == rhs.generation;
+    }
+
+    inline
+    bool
+    isValid(const DockWidgetHandle& handle) noexcept {
+      return handle.generation != 0u;
+    }
+
+  }
+}
+
+#endif    /* DOCK_WIDGET_HANDLE_HXX */
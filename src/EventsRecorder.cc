@@ -0,0 +1,309 @@
+
+# include "EventsRecorder.hh"
+# include <cstring>
+# include <utility>
+
+namespace sdl {
+  namespace app {
+
+    EventsRecorder::EventsRecorder():
+      utils::CoreObject(std::string("events_recorder")),
+
+      m_operationLocker(),
+
+      m_locker(),
+      m_mode(Mode::Idle),
+
+      m_frame(0u),
+      m_start(std::chrono::steady_clock::now()),
+
+      m_out(),
+      m_recorded(0u),
+
+      m_timing(ReplayTiming::Original),
+      m_trace(),
+      m_next(0u),
+
+      m_injecting(false),
+
+      m_previousFilter(nullptr),
+      m_previousFilterData(nullptr)
+    {
+      setService("events");
+    }
+
+    void
+    EventsRecorder::startRecording(const std::string& file) {
+      const std::lock_guard operation(m_operationLocker);
+
+      // Stop any running operation.
+      stopPrivate();
+
+      {
+        const std::lock_guard guard(m_locker);
+
+        m_out.open(file, std::ios::binary | std::ios::trunc);
+        if (!m_out.is_open()) {
+          error(
+            std::string("Could not start recording events to \"") + file + "\"",
+            std::string("Cannot open file")
+          );
+        }
+
+        // Write the header of the trace: it allows to check that the file
+        // is actually a trace when replaying it and that it has been saved
+        // with a compatible version of the library.
+        const std::string magic = getTraceMagic();
+        const std::uint32_t version = getTraceVersion();
+
+        m_out.write(magic.c_str(), magic.size());
+        m_out.write(reinterpret_cast<const char*>(&version), sizeof(version));
+
+        m_start = std::chrono::steady_clock::now();
+        m_recorded = 0u;
+        m_mode = Mode::Record;
+      }
+
+      // Register the watch: it will be notified of each event pumped from
+      // the system queue. This is done without holding the locker as SDL
+      // calls the watch with its own lock acquired.
+      SDL_AddEventWatch(&EventsRecorder::onSystemEvent, this);
+
+      notice("Started recording events to \"" + file + "\"");
+    }
+
+    void
+    EventsRecorder::startReplay(const std::string& file,
+                                const ReplayTiming& timing)
+    {
+      const std::lock_guard operation(m_operationLocker);
+
+      // Stop any running operation.
+      stopPrivate();
+
+      loadTrace(file);
+
+      m_timing = timing;
+      m_next = 0u;
+
+      // Install the filter discarding live input: from now on only the
+      // events of the trace reach the application. Note that SDL discards
+      // the pending events when the filter changes.
+      SDL_EventFilter filter = nullptr;
+      void* data = nullptr;
+      if (SDL_GetEventFilter(&filter, &data) == SDL_TRUE) {
+        m_previousFilter = filter;
+        m_previousFilterData = data;
+      }
+
+      SDL_SetEventFilter(&EventsRecorder::filterLiveInput, this);
+
+      {
+        const std::lock_guard guard(m_locker);
+        m_start = std::chrono::steady_clock::now();
+        m_mode = Mode::Replay;
+      }
+
+      notice("Replaying " + std::to_string(m_trace.size()) + " event(s) from \"" + file + "\"");
+    }
+
+    std::uint16_t
+    EventsRecorder::payloadSize(std::uint32_t type) noexcept {
+      switch (type) {
+        case SDL_QUIT:
+          return sizeof(SDL_QuitEvent);
+        case SDL_WINDOWEVENT:
+          return sizeof(SDL_WindowEvent);
+        case SDL_KEYDOWN:
+        case SDL_KEYUP:
+          return sizeof(SDL_KeyboardEvent);
+        case SDL_TEXTEDITING:
+          return sizeof(SDL_TextEditingEvent);
+        case SDL_TEXTINPUT:
+          return sizeof(SDL_TextInputEvent);
+        case SDL_MOUSEMOTION:
+          return sizeof(SDL_MouseMotionEvent);
+        case SDL_MOUSEBUTTONDOWN:
+        case SDL_MOUSEBUTTONUP:
+          return sizeof(SDL_MouseButtonEvent);
+        case SDL_MOUSEWHEEL:
+          return sizeof(SDL_MouseWheelEvent);
+        case SDL_SYSWMEVENT:
+        case SDL_DROPFILE:
+        case SDL_DROPTEXT:
+          // These events reference memory owned by the system and
+          // cannot be saved.
+          return 0u;
+        default:
+          break;
+      }
+
+      // User events also carry pointers.
+      if (type >= SDL_USEREVENT) {
+        return 0u;
+      }
+
+      return sizeof(SDL_Event);
+    }
+
+    void
+    EventsRecorder::stopPrivate() {
+      // Switch to idle first so that the watch ignores the events it may
+      // still receive before being unregistered.
+      Mode mode = Mode::Idle;
+      {
+        const std::lock_guard guard(m_locker);
+        std::swap(mode, m_mode);
+      }
+
+      if (mode == Mode::Record) {
+        SDL_DelEventWatch(&EventsRecorder::onSystemEvent, this);
+
+        const std::lock_guard guard(m_locker);
+        m_out.close();
+
+        notice("Stopped recording after " + std::to_string(m_recorded) + " event(s)");
+      }
+
+      if (mode == Mode::Replay) {
+        SDL_SetEventFilter(m_previousFilter, m_previousFilterData);
+        m_previousFilter = nullptr;
+        m_previousFilterData = nullptr;
+
+        notice("Stopped replay after " + std::to_string(m_next) + "/" + std::to_string(m_trace.size()) + " event(s)");
+
+        m_trace.clear();
+        m_next = 0u;
+      }
+    }
+
+    void
+    EventsRecorder::loadTrace(const std::string& file) {
+      std::ifstream in(file, std::ios::binary);
+      if (!in.is_open()) {
+        error(
+          std::string("Could not replay events from \"") + file + "\"",
+          std::string("Cannot open file")
+        );
+      }
+
+      // Check the header.
+      const std::string expected = getTraceMagic();
+      std::string magic(expected.size(), '\0');
+      std::uint32_t version = 0u;
+
+      in.read(magic.data(), magic.size());
+      in.read(reinterpret_cast<char*>(&version), sizeof(version));
+
+      if (!in || magic != expected || version != getTraceVersion()) {
+        error(
+          std::string("Could not replay events from \"") + file + "\"",
+          std::string("Invalid trace header")
+        );
+      }
+
+      // Read each record until the end of the file. Each record is made of
+      // the frame and timestamp at which it was recorded, the type of the
+      // event and the payload.
+      m_trace.clear();
+
+      Record record;
+      std::uint32_t type = 0u;
+      std::uint16_t size = 0u;
+
+      while (in.read(reinterpret_cast<char*>(&record.frame), sizeof(record.frame))) {
+        in.read(reinterpret_cast<char*>(&record.timestamp), sizeof(record.timestamp));
+        in.read(reinterpret_cast<char*>(&type), sizeof(type));
+        in.read(reinterpret_cast<char*>(&size), sizeof(size));
+
+        if (!in || size > sizeof(SDL_Event) || size != payloadSize(type)) {
+          error(
+            std::string("Could not replay events from \"") + file + "\"",
+            std::string("Corrupted record ") + std::to_string(m_trace.size())
+          );
+        }
+
+        std::memset(&record.event, 0, sizeof(SDL_Event));
+        in.read(reinterpret_cast<char*>(&record.event), size);
+
+        if (!in) {
+          error(
+            std::string("Could not replay events from \"") + file + "\"",
+            std::string("Truncated record ") + std::to_string(m_trace.size())
+          );
+        }
+
+        m_trace.push_back(record);
+      }
+    }
+
+    void
+    EventsRecorder::record(const SDL_Event& event) {
+      // Discard events which cannot be saved.
+      const std::uint32_t type = event.type;
+      const std::uint16_t size = payloadSize(type);
+
+      if (size == 0u) {
+        return;
+      }
+
+      const std::uint64_t timestamp = elapsedSinceStart();
+
+      m_out.write(reinterpret_cast<const char*>(&m_frame), sizeof(m_frame));
+      m_out.write(reinterpret_cast<const char*>(&timestamp), sizeof(timestamp));
+      m_out.write(reinterpret_cast<const char*>(&type), sizeof(type));
+      m_out.write(reinterpret_cast<const char*>(&size), sizeof(size));
+      m_out.write(reinterpret_cast<const char*>(&event), size);
+
+      ++m_recorded;
+    }
+
+    void
+    EventsRecorder::inject() {
+      // Live user input is discarded by the filter for as long as the replay
+      // runs: the events pushed here are the only ones the application will
+      // fetch from the system queue, which makes the replay deterministic.
+
+      // Determine which events are due: when replaying at the original pace
+      // we use the timestamp of the events, otherwise we push all the events
+      // of the next recorded frame.
+      std::uint64_t elapsed = 0u;
+      {
+        const std::lock_guard guard(m_locker);
+        elapsed = elapsedSinceStart();
+      }
+
+      const std::uint64_t frame = (m_next < m_trace.size() ? m_trace[m_next].frame : 0u);
+
+      while (m_next < m_trace.size()) {
+        Record& record = m_trace[m_next];
+
+        if (m_timing == ReplayTiming::Original && record.timestamp > elapsed) {
+          break;
+        }
+        if (m_timing == ReplayTiming::Fastest && record.frame != frame) {
+          break;
+        }
+
+        // Update the timestamp so that the event looks fresh.
+        record.event.common.timestamp = SDL_GetTicks();
+
+        m_injecting.store(true);
+        const int status = SDL_PushEvent(&record.event);
+        m_injecting.store(false);
+
+        if (status < 0) {
+          warn("Could not inject event " + std::to_string(m_next) + " (err: \"" + SDL_GetError() + "\")");
+        }
+
+        ++m_next;
+      }
+
+      // Stop the replay when all the events have been injected.
+      if (m_next >= m_trace.size()) {
+        stopPrivate();
+      }
+    }
+
+  }
+}
@@ -0,0 +1,214 @@
+#ifndef    EVENTS_RECORDER_HH
+# define   EVENTS_RECORDER_HH
+
+# include <mutex>
+# include <atomic>
+# include <chrono>
+# include <memory>
+# include <vector>
+# include <string>
+# include <fstream>
+# include <cstdint>
+# include <SDL2/SDL.h>
+# include <core_utils/CoreObject.hh>
+
+namespace sdl {
+  namespace app {
+
+    class EventsRecorder: public utils::CoreObject {
+      public:
+
+        /**
+         * @brief - Describes the pace at which a trace is fed back to the
+         *          application when it is replayed.
+         */
+        enum class ReplayTiming {
+          Original,
+          Fastest
+        };
+
+        EventsRecorder();
+
+        virtual ~EventsRecorder();
+
+        /**
+         * @brief - Starts recording all the system events into the file
+         *          specified as input. Any existing content is overriden.
+         *          Any existing record or replay operation is stopped.
+         * @param file - the path to the file where events should be saved.
+         */
+        void
+        startRecording(const std::string& file);
+
+        /**
+         * @brief - Loads the trace from the input `file` and starts to
+         *          inject its content in the system events queue. The
+         *          events are processed as if they were coming from the
+         *          user: any live input is discarded until the replay
+         *          stops.
+         * @param file - the path to the trace to replay.
+         * @param timing - the pace at which events should be injected.
+         */
+        void
+        startReplay(const std::string& file,
+                    const ReplayTiming& timing);
+
+        /**
+         * @brief - Stops any record or replay operation. Does nothing if
+         *          no such operation is running.
+         */
+        void
+        stop();
+
+        bool
+        isRecording() noexcept;
+
+        bool
+        isReplaying() noexcept;
+
+        /**
+         * @brief - Notifies the recorder that a new frame is about to poll
+         *          the system events. Recorded events will be associated
+         *          to this frame and if a replay is active, the events due
+         *          for this frame are pushed to the system queue.
+         *          This method must be called from the main thread as it
+         *          interacts with the system events queue.
+         * @param frame - the index of the frame which is about to start.
+         */
+        void
+        beginFrame(std::uint64_t frame);
+
+      private:
+
+        /**
+         * @brief - Convenience structure describing an event loaded from a
+         *          trace file.
+         */
+        struct Record {
+          std::uint64_t frame;
+          std::uint64_t timestamp;
+          SDL_Event event;
+        };
+
+        enum class Mode {
+          Idle,
+          Record,
+          Replay
+        };
+
+        /**
+         * @brief - Magic value written at the beginning of each trace and
+         *          used to check that a file can be replayed.
+         * @return - the magic string identifying trace files.
+         */
+        static
+        std::string
+        getTraceMagic() noexcept;
+
+        static
+        std::uint32_t
+        getTraceVersion() noexcept;
+
+        /**
+         * @brief - Used to determine how many bytes of the input event should be
+         *          saved to be able to recreate it. This depends on the type of
+         *          the event. Events carrying pointers cannot be saved and a null
+         *          size is returned for them.
+         * @param type - the type of the event.
+         * @return - the size of the payload to save for this event, or `0` if
+         *           the event should not be recorded.
+         */
+        static
+        std::uint16_t
+        payloadSize(std::uint32_t type) noexcept;
+
+        /**
+         * @brief - Callback registered as a watch for the system events queue
+         *          so that each event is recorded as soon as it is fetched.
+         * @param userdata - a pointer to the recorder.
+         * @param event - the event which has just been fetched.
+         * @return - `0` as the return value of a watch is ignored.
+         */
+        static
+        int
+        onSystemEvent(void* userdata,
+                      SDL_Event* event);
+
+        /**
+         * @brief - Callback registered as the filter of the system events queue
+         *          while a replay is running. It discards the user input which
+         *          does not come from the trace so that only recorded events
+         *          reach the application.
+         * @param userdata - a pointer to the recorder.
+         * @param event - the event about to be added to the queue.
+         * @return - `0` if the event should be dropped, `1` otherwise.
+         */
+        static
+        int
+        filterLiveInput(void* userdata,
+                        SDL_Event* event);
+
+        std::uint64_t
+        elapsedSinceStart() const noexcept;
+
+        /**
+         * @brief - Performs the teardown of any running operation assuming the
+         *          operation locker is already acquired.
+         */
+        void
+        stopPrivate();
+
+        void
+        loadTrace(const std::string& file);
+
+        void
+        record(const SDL_Event& event);
+
+        /**
+         * @brief - Pushes the events of the trace which are due at this point
+         *          in the system events queue. Assumes that the operation locker
+         *          is held.
+         */
+        void
+        inject();
+
+      private:
+
+        /**
+         * @brief - Serializes the record and replay operations. The hooks in the
+         *          system events queue are only (un)registered with this locker
+         *          held: as the watch acquires `m_locker` from within SDL, this
+         *          one should never be held while calling SDL.
+         */
+        std::mutex m_operationLocker;
+
+        std::mutex m_locker;
+        Mode m_mode;
+
+        std::uint64_t m_frame;
+        std::chrono::steady_clock::time_point m_start;
+
+        std::ofstream m_out;
+        std::uint64_t m_recorded;
+
+        ReplayTiming m_timing;
+        std::vector<Record> m_trace;
+        std::size_t m_next;
+
+        /**
+         * @brief - Set while the events of the trace are pushed to the system
+         *          queue so that the filter can tell them from live input.
+         */
+        std::atomic<bool> m_injecting;
+
+        SDL_EventFilter m_previousFilter;
+        void* m_previousFilterData;
+    };
+
+    using EventsRecorderShPtr = std::shared_ptr<EventsRecorder>;
+  }
+}
+
+# include "EventsRecorder.hxx"
+
+#endif    /* EVENTS_RECORDER_HH */
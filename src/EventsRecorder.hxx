@@ -0,0 +1,125 @@
+#ifndef    EVENTS_RECORDER_HXX
+# define   EVENTS_RECORDER_HXX
+
+# include "EventsRecorder.hh"
+
+namespace sdl {
+  namespace app {
+
+    inline
+    EventsRecorder::~EventsRecorder() {
+      stop();
+    }
+
+    inline
+    void
+    EventsRecorder::stop() {
+      const std::lock_guard operation(m_operationLocker);
+      stopPrivate();
+    }
+
+    inline
+    bool
+    EventsRecorder::isRecording() noexcept {
+      const std::lock_guard guard(m_locker);
+      return m_mode == Mode::Record;
+    }
+
+    inline
+    bool
+    EventsRecorder::isReplaying() noexcept {
+      const std::lock_guard guard(m_locker);
+      return m_mode == Mode::Replay;
+    }
+
+    inline
+    void
+    EventsRecorder::beginFrame(std::uint64_t frame) {
+      const std::lock_guard operation(m_operationLocker);
+
+      // Keep track of the frame so that recorded events can be associated
+      // to it, and inject the events of the trace if needed. The events are
+      // pushed without holding the locker as SDL calls the watch with its
+      // own lock acquired.
+      bool replaying = false;
+      {
+        const std::lock_guard guard(m_locker);
+        m_frame = frame;
+        replaying = (m_mode == Mode::Replay);
+      }
+
+      if (replaying) {
+        inject();
+      }
+    }
+
+    inline
+    std::string
+    EventsRecorder::getTraceMagic() noexcept {
+      return "SDLTRACE";
+    }
+
+    inline
+    std::uint32_t
+    EventsRecorder::getTraceVersion() noexcept {
+      return 1u;
+    }
+
+    inline
+    std::uint64_t
+    EventsRecorder::elapsedSinceStart() const noexcept {
+      return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - m_start).count();
+    }
+
+    inline
+    int
+    EventsRecorder::onSystemEvent(void* userdata,
+                                  SDL_Event* event)
+    {
+      // The watch is only registered while recording and is called from
+      // the thread pumping the events. The locker is never held while a
+      // SDL function is called so we can safely acquire it.
+      EventsRecorder* recorder = reinterpret_cast<EventsRecorder*>(userdata);
+      if (recorder == nullptr || event == nullptr) {
+        return 0;
+      }
+
+      const std::lock_guard guard(recorder->m_locker);
+      if (recorder->m_mode == Mode::Record) {
+        recorder->record(*event);
+      }
+
+      return 0;
+    }
+
+    inline
+    int
+    EventsRecorder::filterLiveInput(void* userdata,
+                                    SDL_Event* event)
+    {
+      // The filter is called with the lock of the system queue acquired so
+      // it only relies on the atomic injection flag. The previous filter is
+      // not modified as long as this one is registered.
+      EventsRecorder* recorder = reinterpret_cast<EventsRecorder*>(userdata);
+      if (recorder == nullptr || event == nullptr) {
+        return 1;
+      }
+
+      // Drop user input which does not come from the trace. Window and quit
+      // events are kept so that the application can still be closed.
+      const bool input = (event->type >= SDL_KEYDOWN && event->type <= SDL_MULTIGESTURE);
+      if (input && !recorder->m_injecting.load()) {
+        return 0;
+      }
+
+      if (recorder->m_previousFilter != nullptr) {
+        return recorder->m_previousFilter(recorder->m_previousFilterData, event);
+      }
+
+      return 1;
+    }
+
+  }
+}
+
+#endif    /* EVENTS_RECORDER_HXX */
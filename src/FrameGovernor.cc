@@ -0,0 +1,145 @@
+
+# include "FrameGovernor.hh"
+# include <algorithm>
+
+namespace sdl {
+  namespace app {
+
+    FrameGovernor::FrameGovernor():
+      utils::CoreObject(std::string("frame_governor")),
+
+      m_enabled(false),
+      m_changed(false),
+      m_steps(),
+      m_level(0u),
+
+      m_history(sk_window, false),
+      m_next(0u),
+      m_overruns(0u),
+      m_calm(0u),
+
+      m_interval(5000.0f),
+      m_lastSummary(Clock::now()),
+      m_frames(0u),
+      m_summaryOverruns(0u),
+      m_worst(0.0f),
+      m_excess(0.0f)
+    {
+      setService("governor");
+
+      // Default degradation: first reduce the repaint of the peripheral areas
+      // and then lower the framerate.
+      setSteps(
+        std::vector<Step>{
+          Step{1.0f, 2u},
+          Step{0.75f, 2u},
+          Step{0.5f, 4u}
+        }
+      );
+    }
+
+    void
+    FrameGovernor::setSteps(const std::vector<Step>& steps) {
+      m_steps.clear();
+      m_steps.push_back(Step{1.0f, 1u});
+
+      for (unsigned id = 0u ; id < steps.size() ; ++id) {
+        if (steps[id].framerate <= 0.0f || steps[id].framerate > 1.0f) {
+          error(
+            std::string("Could not set degradation steps"),
+            std::string("Invalid framerate factor ") + std::to_string(steps[id].framerate)
+          );
+        }
+
+        m_steps.push_back(Step{steps[id].framerate, std::max(1u, steps[id].divider)});
+      }
+
+      m_level = std::min(m_level, static_cast<unsigned>(m_steps.size() - 1u));
+      m_changed = true;
+    }
+
+    bool
+    FrameGovernor::account(float duration,
+                           float budget)
+    {
+      const bool overrun = (duration > budget);
+
+      // Update the sliding window.
+      if (m_history[m_next]) {
+        --m_overruns;
+      }
+      m_history[m_next] = overrun;
+      if (overrun) {
+        ++m_overruns;
+      }
+      m_next = (m_next + 1u) % sk_window;
+
+      // Update statistics for the summary.
+      ++m_frames;
+      if (overrun) {
+        ++m_summaryOverruns;
+        m_worst = std::max(m_worst, duration);
+        m_excess += duration - budget;
+      }
+
+      summarize(Clock::now());
+
+      const bool changed = m_changed;
+      m_changed = false;
+
+      if (!m_enabled) {
+        return changed;
+      }
+
+      // Count the consecutive frames with some headroom.
+      m_calm = (duration < sk_headroom * budget ? m_calm + 1u : 0u);
+
+      const unsigned prev = m_level;
+
+      if (m_overruns > sk_overrunRatio * sk_window && m_level + 1u < m_steps.size()) {
+        ++m_level;
+      }
+      else if (m_calm >= sk_recovery && m_level > 0u) {
+        --m_level;
+      }
+
+      if (m_level == prev) {
+        return changed;
+      }
+
+      // Start from a clean state to evaluate the new level.
+      resetHistory();
+
+      notice(
+        "Switched to degradation level " + std::to_string(m_level) + " (framerate x" +
+        std::to_string(getStep().framerate) + ", peripheral areas every " +
+        std::to_string(getStep().divider) + " frame(s))"
+      );
+
+      return true;
+    }
+
+    void
+    FrameGovernor::summarize(const Clock::time_point& now) {
+      const float elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - m_lastSummary).count();
+      if (elapsed < m_interval) {
+        return;
+      }
+
+      if (m_summaryOverruns > 0u) {
+        warn(
+          std::to_string(m_summaryOverruns) + "/" + std::to_string(m_frames) + " frame(s) overran their budget in the last " +
+          std::to_string(elapsed) + "ms (worst: " + std::to_string(m_worst) + "ms, average excess: " +
+          std::to_string(m_excess / m_summaryOverruns) + "ms, level: " + std::to_string(m_level) + ")"
+        );
+      }
+
+      m_lastSummary = now;
+      m_frames = 0u;
+      m_summaryOverruns = 0u;
+      m_worst = 0.0f;
+      m_excess = 0.0f;
+    }
+
+  }
+}
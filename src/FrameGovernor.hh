@@ -0,0 +1,180 @@
+#ifndef    FRAME_GOVERNOR_HH
+# define   FRAME_GOVERNOR_HH
+
+# include <chrono>
+# include <memory>
+# include <vector>
+# include <cstdint>
+# include <core_utils/CoreObject.hh>
+
+namespace sdl {
+  namespace app {
+
+    /**
+     * @brief - Keeps track of the frames exceeding their budget and degrades the
+     *          rendering step by step when overruns are sustained. Each step can
+     *          lower the framerate and reduce the rate at which the peripheral
+     *          areas of the application are repainted. The degradation is rolled
+     *          back once the load subsides.
+     *          Rather than logging each overrun the governor periodically emits a
+     *          summary of the overruns which happened during the last interval.
+     *          The degradation is disabled by default: only the summaries are
+     *          produced until it is activated.
+     */
+    class FrameGovernor: public utils::CoreObject {
+      public:
+
+        using Clock = std::chrono::steady_clock;
+
+        /**
+         * @brief - Describes a degradation step. The `framerate` is a factor of
+         *          the desired framerate of the application while the `divider`
+         *          indicates that the peripheral areas are only repainted once
+         *          every `divider` frames.
+         */
+        struct Step {
+          float framerate;
+          unsigned divider;
+        };
+
+        FrameGovernor();
+
+        virtual ~FrameGovernor();
+
+        /**
+         * @brief - Activates or deactivates the degradation of the rendering. When
+         *          deactivated the nominal rendering is restored.
+         * @param enabled - whether the degradation should be active.
+         */
+        void
+        setEnabled(bool enabled) noexcept;
+
+        bool
+        isEnabled() const noexcept;
+
+        /**
+         * @brief - Defines the degradation steps applied one after the other when
+         *          overruns are sustained. An implicit step corresponding to the
+         *          nominal rendering is always used first.
+         * @param steps - the list of degradation steps.
+         */
+        void
+        setSteps(const std::vector<Step>& steps);
+
+        /**
+         * @brief - Defines the interval between two summaries of the overruns.
+         * @param interval - the interval in milliseconds.
+         */
+        void
+        setSummaryInterval(float interval) noexcept;
+
+        /**
+         * @brief - Returns the current degradation step, `0` meaning that no
+         *          degradation is applied.
+         * @return - the current level of degradation.
+         */
+        unsigned
+        getLevel() const noexcept;
+
+        /**
+         * @brief - Returns the factor to apply to the desired framerate given the
+         *          current level of degradation.
+         * @return - the factor to apply to the framerate.
+         */
+        float
+        getFramerateFactor() const noexcept;
+
+        /**
+         * @brief - Determines whether the peripheral areas should be repainted
+         *          during the input `frame`.
+         * @param frame - the index of the frame.
+         * @return - `true` if the peripheral areas should be repainted.
+         */
+        bool
+        shouldRepaintPeripheral(std::uint64_t frame) const noexcept;
+
+        /**
+         * @brief - Accounts for a new frame and updates the level of degradation
+         *          if needed.
+         * @param duration - the time it took to produce the frame in milliseconds.
+         * @param budget - the time allocated to a frame in milliseconds.
+         * @return - `true` if the level of degradation changed, or if the governor
+         *           was reconfigured since the last call.
+         */
+        bool
+        account(float duration,
+                float budget);
+
+      private:
+
+        const Step&
+        getStep() const noexcept;
+
+        /**
+         * @brief - Logs the summary of the overruns recorded since the previous
+         *          summary if the interval elapsed.
+         * @param now - the current time.
+         */
+        void
+        summarize(const Clock::time_point& now);
+
+      private:
+
+        /**
+         * @brief - Number of frames over which the ratio of overruns is computed
+         *          along with the ratio above which a degradation is applied. The
+         *          `sk_recovery` describes the number of consecutive frames using
+         *          less than `sk_headroom` of their budget required to roll back
+         *          a degradation step.
+         */
+        static constexpr unsigned sk_window = 30u;
+        static constexpr float sk_overrunRatio = 0.5f;
+        static constexpr unsigned sk_recovery = 120u;
+        static constexpr float sk_headroom = 0.6f;
+
+        /**
+         * @brief - Clears the sliding window of the recent frames so that a new
+         *          level of degradation is evaluated from a clean state.
+         */
+        void
+        resetHistory() noexcept;
+
+      private:
+
+        /**
+         * @brief - The `m_changed` boolean indicates that the governor was enabled,
+         *          disabled or received new steps since the last frame accounted:
+         *          it is reported by the next call to `account`.
+         */
+        bool m_enabled;
+        bool m_changed;
+        std::vector<Step> m_steps;
+        unsigned m_level;
+
+        /**
+         * @brief - Sliding window of the most recent frames, indicating for each
+         *          one whether it exceeded its budget.
+         */
+        std::vector<bool> m_history;
+        unsigned m_next;
+        unsigned m_overruns;
+        unsigned m_calm;
+
+        /**
+         * @brief - Statistics about the overruns since the last summary.
+         */
+        float m_interval;
+        Clock::time_point m_lastSummary;
+        unsigned m_frames;
+        unsigned m_summaryOverruns;
+        float m_worst;
+        float m_excess;
+    };
+
+    using FrameGovernorShPtr = std::shared_ptr<FrameGovernor>;
+  }
+}
+
+# include "FrameGovernor.hxx"
+
+#endif    /* FRAME_GOVERNOR_HH */
@@ -0,0 +1,71 @@
+#ifndef    FRAME_GOVERNOR_HXX
+# define   FRAME_GOVERNOR_HXX
+
+# include <algorithm>
+# include "FrameGovernor.hh"
+
+namespace sdl {
+  namespace app {
+
+    inline
+    FrameGovernor::~FrameGovernor() {}
+
+    inline
+    void
+    FrameGovernor::setEnabled(bool enabled) noexcept {
+      m_enabled = enabled;
+      m_changed = true;
+
+      m_level = 0u;
+      resetHistory();
+    }
+
+    inline
+    bool
+    FrameGovernor::isEnabled() const noexcept {
+      return m_enabled;
+    }
+
+    inline
+    void
+    FrameGovernor::setSummaryInterval(float interval) noexcept {
+      m_interval = std::max(0.0f, interval);
+    }
+
+    inline
+    unsigned
+    FrameGovernor::getLevel() const noexcept {
+      return m_level;
+    }
+
+    inline
+    float
+    FrameGovernor::getFramerateFactor() const noexcept {
+      return getStep().framerate;
+    }
+
+    inline
+    bool
+    FrameGovernor::shouldRepaintPeripheral(std::uint64_t frame) const noexcept {
+      const unsigned divider = getStep().divider;
+      return divider <= 1u || frame % divider == 0u;
+    }
+
+    inline
+    const FrameGovernor::Step&
+    FrameGovernor::getStep() const noexcept {
+      return m_steps[m_level];
+    }
+
+    inline
+    void
+    FrameGovernor::resetHistory() noexcept {
+      std::fill(m_history.begin(), m_history.end(), false);
+      m_overruns = 0u;
+      m_calm = 0u;
+    }
+
+  }
+}
+
+#endif    /* FRAME_GOVERNOR_HXX */
@@ -0,0 +1,102 @@
+
+# include "IdleTasks.hh"
+# include <thread>
+
+namespace sdl {
+  namespace app {
+
+    IdleTasks::IdleTasks():
+      utils::CoreObject(std::string("idle_tasks")),
+
+      m_locker(),
+      m_nextID(0u),
+      m_entries(),
+
+      m_running()
+    {
+      setService("tasks");
+    }
+
+    float
+    IdleTasks::run(const Clock::time_point& deadline,
+                   const Locker& locker)
+    {
+      const Clock::time_point start = Clock::now();
+
+      // Retrieve the tasks to run during this frame.
+      {
+        const std::lock_guard guard(m_locker);
+        m_running = m_entries;
+      }
+
+      for (unsigned id = 0u ; id < m_running.size() ; ++id) {
+        m_running[id]->idle = false;
+      }
+
+      // Call each task in turn until either all of them are done or we run
+      // out of time. We use the average duration of each task to determine
+      // whether it can still be executed before the `deadline`.
+      bool stillWork = !m_running.empty();
+
+      while (stillWork) {
+        stillWork = false;
+
+        for (unsigned id = 0u ; id < m_running.size() ; ++id) {
+          Entry& entry = *m_running[id];
+          if (entry.idle) {
+            continue;
+          }
+
+          const Clock::time_point now = Clock::now();
+          const float remaining = std::chrono::duration_cast<std::chrono::microseconds>(deadline - now).count() / 1000.0f;
+
+          if (remaining <= entry.average) {
+            // Not enough time left for this task.
+            entry.idle = true;
+            continue;
+          }
+
+          {
+            // The task may have been removed since the beginning of the frame.
+            const std::lock_guard guard(m_locker);
+            if (entry.removed) {
+              entry.idle = true;
+              continue;
+            }
+          }
+
+          // Perform a unit of work. In case the task fails, we consider it as
+          // done for this frame. The lock is released as soon as the unit is
+          // done and we yield to give a chance to other threads to get it.
+          bool more = false;
+          {
+            std::unique_lock<std::recursive_mutex> guard;
+            if (locker) {
+              guard = locker();
+            }
+
+            withSafetyNet(
+              [&entry, &more]() {
+                more = entry.task();
+              },
+              entry.name
+            );
+          }
+
+          std::this_thread::yield();
+
+          const float duration = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - now).count() / 1000.0f;
+          entry.average = (entry.average <= 0.0f ? duration : 0.8f * entry.average + 0.2f * duration);
+
+          entry.idle = !more;
+          stillWork = stillWork || more;
+        }
+      }
+
+      m_running.clear();
+
+      return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count() / 1000.0f;
+    }
+
+  }
+}
@@ -0,0 +1,118 @@
+#ifndef    IDLE_TASKS_HH
+# define   IDLE_TASKS_HH
+
+# include <mutex>
+# include <chrono>
+# include <memory>
+# include <vector>
+# include <string>
+# include <functional>
+# include <core_utils/CoreObject.hh>
+
+namespace sdl {
+  namespace app {
+
+    class IdleTasks: public utils::CoreObject {
+      public:
+
+        /**
+         * @brief - An idle task is called repeatedly as long as there is some
+         *          time left in the frame. Each call should only perform a small
+         *          unit of work (for example warming a single cache entry) and
+         *          return `true` if there is still some work to do. When it returns
+         *          `false`, the task is not called anymore until the next frame.
+         */
+        using Task = std::function<bool()>;
+
+        using Clock = std::chrono::steady_clock;
+
+        /**
+         * @brief - Used to acquire the locker protecting the data accessed by the
+         *          tasks. It is called before each unit of work and the lock it
+         *          returns is released right after it.
+         */
+        using Locker = std::function<std::unique_lock<std::recursive_mutex>()>;
+
+        IdleTasks();
+
+        virtual ~IdleTasks();
+
+        /**
+         * @brief - Registers a new idle task. This method can be called from
+         *          any thread.
+         * @param task - the task to register.
+         * @return - an identifier which can be used to remove the task.
+         */
+        unsigned
+        add(Task task);
+
+        /**
+         * @brief - Unregisters the task with the specified identifier. Nothing
+         *          happens if no such task exists.
+         * @param id - the identifier of the task to remove.
+         */
+        void
+        remove(unsigned id);
+
+        bool
+        empty() noexcept;
+
+        /**
+         * @brief - Calls the registered tasks in a round-robin fashion until the
+         *          `deadline` is reached or all tasks report that they have no
+         *          more work to do. Tasks are pre-empted cooperatively: a task is
+         *          not called if its average duration would make it overrun the
+         *          `deadline`.
+         *          The `locker` is only held while a unit of work is performed: the
+         *          thread yields between two units so that other threads waiting
+         *          for it are not starved during the whole idle time.
+         * @param deadline - the time at which the tasks should be done.
+         * @param locker - used to acquire the lock protecting each unit of work.
+         *                 If empty, the tasks are executed without any lock.
+         * @return - the time spent in the tasks, in milliseconds.
+         */
+        float
+        run(const Clock::time_point& deadline,
+            const Locker& locker = Locker());
+
+      private:
+
+        /**
+         * @brief - Convenience structure describing a registered task. Along with
+         *          the task itself we keep track of an estimation of its duration
+         *          so that we can avoid calling it when not enough time is left
+         *          in the frame. The `idle` flag indicates that the task has no
+         *          more work to do for the current frame.
+         */
+        struct Entry {
+          unsigned id;
+          std::string name;
+          Task task;
+          float average;
+          bool idle;
+          bool removed;
+        };
+
+        using EntryShPtr = std::shared_ptr<Entry>;
+
+      private:
+
+        std::mutex m_locker;
+        unsigned m_nextID;
+        std::vector<EntryShPtr> m_entries;
+
+        /**
+         * @brief - Copy of the registered tasks used while running them. This
+         *          allows tasks to register or remove other tasks (including
+         *          themselves) while being executed.
+         */
+        std::vector<EntryShPtr> m_running;
+    };
+
+    using IdleTasksShPtr = std::shared_ptr<IdleTasks>;
+  }
+}
+
+# include "IdleTasks.hxx"
+
+#endif    /* IDLE_TASKS_HH */
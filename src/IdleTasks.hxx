@@ -0,0 +1,56 @@
+#ifndef    IDLE_TASKS_HXX
+# define   IDLE_TASKS_HXX
+
+# include "IdleTasks.hh"
+
+namespace sdl {
+  namespace app {
+
+    inline
+    IdleTasks::~IdleTasks() {}
+
+    inline
+    unsigned
+    IdleTasks::add(Task task) {
+      // Check degenerate cases.
+      if (!task) {
+        error(std::string("Cannot register invalid idle task"));
+      }
+
+      const std::lock_guard guard(m_locker);
+
+      const unsigned id = m_nextID;
+      ++m_nextID;
+
+      m_entries.push_back(std::make_shared<Entry>(Entry{id, std::string("idle_task_") + std::to_string(id), task, 0.0f, false, false}));
+
+      return id;
+    }
+
+    inline
+    void
+    IdleTasks::remove(unsigned id) {
+      const std::lock_guard guard(m_locker);
+
+      for (unsigned index = 0u ; index < m_entries.size() ; ++index) {
+        if (m_entries[index]->id == id) {
+          // Mark the entry as removed in case it is currently running.
+          m_entries[index]->removed = true;
+          m_entries.erase(m_entries.begin() + index);
+
+          return;
+        }
+      }
+    }
+
+    inline
+    bool
+    IdleTasks::empty() noexcept {
+      const std::lock_guard guard(m_locker);
+      return m_entries.empty();
+    }
+
+  }
+}
+
+#endif    /* IDLE_TASKS_HXX */
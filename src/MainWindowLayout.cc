@@ -19,7 +19,33 @@ namespace sdl {
       m_statusBarPercentage(),
 
       m_hLayout(std::string("m_hLayout"), nullptr, 3u, 3u, margin),
-      m_vLayout(std::string("m_vLayout"), nullptr, 1u, 6u, margin)
+      m_vLayout(std::string("m_vLayout"), nullptr, 1u, 6u, margin),
+
+      m_updateDepth(0u),
+      m_geometryDeferred(false),
+
+      m_geometrySolved(false),
+      m_structureChanged(true),
+      m_lastWindow(),
+      m_boxes(),
+      m_itemsStale(false),
+
+      m_referenceValid(false),
+      m_referenceWindow(),
+      m_referenceSize(),
+      m_referenceBoxes(),
+
+      m_cacheLocker(),
+      m_cacheCapacity(8u),
+      m_cache(),
+      m_cacheHits(0u),
+      m_cacheMisses(0u),
+
+      m_generation(0u),
+
+      m_tracer(),
+      m_logSink(std::make_shared<AsyncLogSink>()),
+      m_logSource(m_logSink->registerSource(getName(), std::string("main_layout")))
     {
       // Assign the percentages from the input central widget size.
       assignPercentagesFromCentralWidget(centralWidgetSize);
@@ -57,8 +83,7 @@ namespace sdl {
       }
 
       // Check that this item is registered in the information array.
-      InfosMap::const_iterator info = m_infos.find(id);
-      if (info == m_infos.cend()) {
+      if (!hasInfo(id)) {
         error(
           std::string("Cannot retrieve role for item \"") + item->getName() + "\"",
           std::string("Inexisting key")
@@ -68,10 +93,10 @@ namespace sdl {
       // Check whether the role for this item is actually a dock widget. In
       // any other case we abort the deletion of the item as it is not what
       // is expected by the caller.
-      if (!isDockWidgetRole(info->second.role)) {
+      if (!isDockWidgetRole(m_infos.roles[id])) {
         error(
           std::string("Could not remove item \"") + item->getName() + "\" which is not a dock widget",
-          std::string("Role \"") + roleToName(info->second.role) + " is not a valid dock widget role"
+          std::string("Role \"") + roleToName(m_infos.roles[id]) + " is not a valid dock widget role"
         );
       }
 
@@ -90,76 +115,192 @@ namespace sdl {
       // We use the standard process to subtract the margin from the input size and to compute information
       // about the widgets, so that we get a way to iterate on registered widgets.
 
+      // Delay the computation in case a batch of modifications is in progress. Note
+      // that we flag the request before checking the batch so that it cannot be lost
+      // if the batch ends concurrently.
+      m_geometryDeferred = true;
+      if (m_updateDepth > 0u) {
+        return;
+      }
+      m_geometryDeferred = false;
+
+      const Tracer::Scope scope(m_tracer.get(), "layout", "compute_geometry");
+
       const utils::Sizef internalSize = computeAvailableSize(window);
 
       // Retrieve widgets' info.
       std::vector<core::Layout::WidgetInfo> infos = computeItemsInfo();
 
+      // Solving the internal layouts is costly so we try to only solve the ones which are
+      // affected by the modifications since the last computation. A change in the structure
+      // of the layout or in the available size requires both layouts to be updated while a
+      // change in the visibility or in the size constraints of a widget only requires to
+      // update the layouts where the widget is registered.
+      const bool sizeChanged =
+        !m_geometrySolved ||
+        !(window.toSize() == m_lastWindow.toSize()) ||
+        window.x() != m_lastWindow.x() ||
+        window.y() != m_lastWindow.y();
+      const bool structureChanged = m_structureChanged;
+      bool hDirty = structureChanged || sizeChanged || m_itemsStale;
+      bool vDirty = structureChanged || sizeChanged || m_itemsStale;
+      bool visibilityChanged = false;
+      bool constraintsChanged = false;
+
       // We need to update the maximum size of each virtual layout item based on the inpu `window` size.
       // This will ensure that each individual virtual item is set up with up to date information regarding
-      // its size.
-      // We need to traverse each virtual layout item and use the dedicated handler to update the maximum
-      // size to its latest value.
-      // In addition to that we need to update the visibility status of the virtual layout item based on the
-      // current visibility status of each widget.
-      for (InfosMap::const_iterator widgetInfo = m_infos.cbegin() ;
-           widgetInfo != m_infos.cend() ;
-           ++widgetInfo)
-      {
+      // its size. This is only needed when the size changed or new items were added.
+      // In addition to that we need to update the constraints and the visibility status of the virtual
+      // layout item based on the current state of each widget.
+      for (unsigned id = 0u ; id < m_infos.valid.size() ; ++id) {
+        if (!m_infos.valid[id]) {
+          continue;
+        }
+
+        // Update the size constraints if the widget modified them.
+        const bool constrained = !sameConstraints(infos[id], m_infos.constraints[id]);
+        if (constrained) {
+          m_infos.items[id]->setSizePolicy(infos[id].policy);
+          m_infos.items[id]->setMinSize(infos[id].min);
+          m_infos.items[id]->setSizeHint(infos[id].hint);
+          m_infos.items[id]->setMaxSize(infos[id].max);
+          m_infos.constraints[id] = infos[id];
+
+          std::pair<bool, bool> manageDims = dimensionManagedForRole(m_infos.roles[id]);
+          hDirty = hDirty || manageDims.first;
+          vDirty = vDirty || manageDims.second;
+          constraintsChanged = true;
+        }
+
         // Update max size.
-        utils::Sizef maxFromLayout = computeMaxSizeForRole(internalSize, widgetInfo->second.role);
-        widgetInfo->second.item->updateMaxSize(maxFromLayout);
+        if (hDirty || vDirty || constrained) {
+          utils::Sizef maxFromLayout = computeMaxSizeForRole(internalSize, m_infos.roles[id]);
+          m_infos.items[id]->updateMaxSize(maxFromLayout);
+        }
 
         // Update visibility status.
-        widgetInfo->second.item->setVisible(infos[widgetInfo->first].visible);
+        const bool visible = infos[id].visible;
+        if (visible != m_infos.visible[id]) {
+          m_infos.items[id]->setVisible(visible);
+          m_infos.visible[id] = visible;
+
+          std::pair<bool, bool> manageDims = dimensionManagedForRole(m_infos.roles[id]);
+          hDirty = hDirty || manageDims.first;
+          vDirty = vDirty || manageDims.second;
+          visibilityChanged = true;
+        }
+      }
+
+      m_lastWindow = window;
+      m_structureChanged = false;
+      m_geometrySolved = true;
+
+      // In case nothing changed, we can reuse the areas computed last time.
+      if (!hDirty && !vDirty) {
+        m_logSink->log(m_logSource, AsyncLogSink::Level::Verbose, "Reusing {} cached area(s)", m_boxes.size());
+        assignRenderingAreas(m_boxes, window);
+        return;
+      }
+
+      // The reference solution was computed with the previous constraints.
+      if (structureChanged || visibilityChanged || constraintsChanged) {
+        m_referenceValid = false;
+      }
+
+      // Check whether this configuration was already computed: the same window size and
+      // set of visible widgets yield the same areas. Note that the cache is only valid
+      // as long as the structure of the layout and the constraints of the widgets do not
+      // change.
+      if (structureChanged || constraintsChanged) {
+        clearCache();
+      }
+
+      const CacheKey key = buildCacheKey(window);
+
+      if (fetchFromCache(key)) {
+        // The virtual layout items do not reflect the areas anymore: the next update will
+        // require to solve both layouts.
+        m_itemsStale = true;
+
+        assignRenderingAreas(m_boxes, window);
+        ++m_generation;
+        return;
+      }
+
+      // During a resize of the window, the structure of the layout does not change: the
+      // same widgets are visible and the percentages are the same. As long as no widget
+      // is constrained by its own size bounds, the solution of the internal layouts is
+      // proportional to the available size (the maximum size of each role is expressed
+      // as a percentage of the window) and we can derive the areas of each widget from
+      // the last complete solution.
+      if (sizeChanged && m_referenceValid && computeGeometryFromReference(window, internalSize)) {
+        // The virtual layout items do not reflect the areas anymore: the next update will
+        // require to solve both layouts.
+        m_itemsStale = true;
+
+        m_logSink->log(m_logSource, AsyncLogSink::Level::Verbose, "Scaled {} area(s) from reference solution", m_boxes.size());
+        saveToCache(key, false);
+        assignRenderingAreas(m_boxes, window);
+        ++m_generation;
+        return;
       }
 
       // Compute geometry of internal layouts. Virtual layout item need to be set up in order to care about
       // the modification of width or height based on the layout which is currently applied to them.
       // For instance, the virtual layout item representing the central dock widget is registered in both
       // the horizontal layout and the vertical layout. However we do not want the width computed by the
-      // `m_vLayout` to override the value computed by the `m_hLayout`. Thus we need to manually set the
-      // the manage dimensions flags between calls to each layout.
-
-      // Activate width management for each widget role.
-      for (InfosMap::const_iterator widgetInfo = m_infos.cbegin() ;
-           widgetInfo != m_infos.cend() ;
-           ++widgetInfo)
-      {
-        std::pair<bool, bool> manageDims = dimensionManagedForRole(widgetInfo->second.role);
-        widgetInfo->second.item->setManageWidth(manageDims.first);
-
-        if (!manageDims.first) {
-          // The role do not support width management, we thus need to assign the total width
-          // available to the virtual layout item.
-          widgetInfo->second.item->setX(0.0f);
-          widgetInfo->second.item->setWidth(internalSize.w());
+      // `m_vLayout` to override the value computed by the `m_hLayout` (and conversely). Thus we need to
+      // manually set the the manage dimensions flags between calls to each layout. This also guarantees
+      // that each layout only modifies its own dimension, which allows to solve only one of them when
+      // needed.
+
+      if (hDirty) {
+        // Activate width management for each widget role. Also, deactivate height management for each widget.
+        for (unsigned id = 0u ; id < m_infos.valid.size() ; ++id) {
+          if (!m_infos.valid[id]) {
+            continue;
+          }
+
+          std::pair<bool, bool> manageDims = dimensionManagedForRole(m_infos.roles[id]);
+
+          m_infos.items[id]->setManageWidth(manageDims.first);
+          m_infos.items[id]->setManageHeight(false);
+
+          if (!manageDims.first) {
+            // The role do not support width management, we thus need to assign the total width
+            // available to the virtual layout item.
+            m_infos.items[id]->setX(0.0f);
+            m_infos.items[id]->setWidth(internalSize.w());
+          }
         }
+
+        m_logSink->log(m_logSource, AsyncLogSink::Level::Notice, "Updating h layout");
+        m_hLayout.update(window);
       }
 
-      notice("Updating h layout");
-      m_hLayout.update(window);
+      if (vDirty) {
+        // Activate height management for each widget role. Also, deactivate width management for each widget.
+        for (unsigned id = 0u ; id < m_infos.valid.size() ; ++id) {
+          if (!m_infos.valid[id]) {
+            continue;
+          }
 
-      // Activate height management for each widget role. Also, deactivate width management for each widget.
-      for (InfosMap::const_iterator widgetInfo = m_infos.cbegin() ;
-           widgetInfo != m_infos.cend() ;
-           ++widgetInfo)
-      {
-        std::pair<bool, bool> manageDims = dimensionManagedForRole(widgetInfo->second.role);
+          std::pair<bool, bool> manageDims = dimensionManagedForRole(m_infos.roles[id]);
 
-        widgetInfo->second.item->setManageHeight(manageDims.second);
-        widgetInfo->second.item->setManageWidth(false);
+          m_infos.items[id]->setManageHeight(manageDims.second);
+          m_infos.items[id]->setManageWidth(false);
 
-        if (!manageDims.second) {
-          // The role do not support height management, we thus need to assign the total height
-          // available to the virtual layout item.
-          widgetInfo->second.item->setY(0.0f);
-          widgetInfo->second.item->setHeight(internalSize.h());
+          if (!manageDims.second) {
+            // The role do not support height management, we thus need to assign the total height
+            // available to the virtual layout item.
+            m_infos.items[id]->setY(0.0f);
+            m_infos.items[id]->setHeight(internalSize.h());
+          }
         }
-      }
 
-      notice("Updating v layout");
-      m_vLayout.update(window);
+        m_logSink->log(m_logSource, AsyncLogSink::Level::Notice, "Updating v layout");
+        m_vLayout.update(window);
+      }
 
       // Now build the area to assign to each widget based on the internal virtual items. There are
       // only two exceptions to the general process: the left and right dock widget. Indeed we have
@@ -217,12 +358,13 @@ namespace sdl {
 
       bool noInfoForDockAreas = true;
 
-      for (InfosMap::const_iterator widgetInfo = m_infos.cbegin() ;
-           widgetInfo != m_infos.cend() ;
-           ++widgetInfo)
-      {
-        const WidgetRole& role = widgetInfo->second.role;
-        const utils::Boxf area = widgetInfo->second.item->getRenderingArea();
+      for (unsigned id = 0u ; id < m_infos.valid.size() ; ++id) {
+        if (!m_infos.valid[id]) {
+          continue;
+        }
+
+        const WidgetRole& role = m_infos.roles[id];
+        const utils::Boxf area = m_infos.items[id]->getRenderingArea();
 
         // Check whether this item is useful for our computation: we keep track of the
         // largest widget encountered so far for each role.
@@ -280,82 +422,196 @@ namespace sdl {
         offsetOrdinate = offsetOrdinate - combinedHeight / 2.0f;
       }
 
-      std::vector<utils::Boxf> boxes(m_infos.size());
+      m_boxes.resize(infos.size());
+
+      for (unsigned id = 0u ; id < m_infos.valid.size() ; ++id) {
+        if (!m_infos.valid[id]) {
+          continue;
+        }
 
-      for (InfosMap::const_iterator widgetInfo = m_infos.cbegin() ;
-           widgetInfo != m_infos.cend() ;
-           ++widgetInfo)
-      {
         // Retrieve the widget's info.
-        const ItemInfo& info = widgetInfo->second;
+        const WidgetRole& role = m_infos.roles[id];
+        const graphic::VirtualLayoutItemShPtr& item = m_infos.items[id];
 
         // Check for special case of left and right dock areas.
-        if (info.role == WidgetRole::LeftDockWidget || info.role == WidgetRole::RightDockWidget) {
-          info.item->setY(offsetOrdinate);
-          info.item->setHeight(combinedHeight);
+        if (role == WidgetRole::LeftDockWidget || role == WidgetRole::RightDockWidget) {
+          item->setY(offsetOrdinate);
+          item->setHeight(combinedHeight);
         }
 
         // The box is obtained directly through the virtual layout item associated to this widget.
-        boxes[widgetInfo->first] = info.item->getRenderingArea();
+        m_boxes[id] = item->getRenderingArea();
       }
 
+      // Save this solution as reference for subsequent resize operations.
+      m_itemsStale = false;
+
+      m_referenceValid = true;
+      m_referenceWindow = window;
+      m_referenceSize = internalSize;
+      m_referenceBoxes = m_boxes;
+
+      saveToCache(key, true);
+
       // Assign the areas using the dedicated handler.
-      assignRenderingAreas(boxes, window);
+      assignRenderingAreas(m_boxes, window);
+      ++m_generation;
     }
 
-    void
-    MainWindowLayout::removeAll(const WidgetRole& role) {
-      // Traverse the internal table of content and remove each one which role matches
-      // the input value. The process is not as straightforward as it seems as we cannot
-      // really rely on the index of the item to perform the removal.
-      // Indeed consider the following situation:
-      //
-      // Content of `m_items`:
-      //
-      // m_items[0] = role
-      // m_items[1] = not_role
-      // m_items[2] = role
-      //
-      // Content of `m_infos`:
-      //
-      // m_infos[0] = widget_0
-      // m_infos[1] = widget_1
-      // m_infos[2] = widget_2
-      //
-      // We need to remove the item 0 and 2. If we just traverse the internal list of info,
-      // select the one matching the input `role` and then sequentially perform the removal
-      // of each one, we will run into trouble because the indices of the items will change
-      // precisely because of the removal of other items.
-      // So instead we have to rely on a less efficient strategy to remove one item at a
-      // time and continue removing items until no more can be found for this role.
-
-      // Iterate until no more items are found for the input `role`.
-      bool stillWidgetWithRole = true;
-      do {
-        // Create an iterator to traverse the internal table.
-        InfosMap::const_iterator info = m_infos.cbegin();
-        while (info != m_infos.cend() && info->second.role != role) {
-          ++info;
-        }
+    bool
+    MainWindowLayout::computeGeometryFromReference(const utils::Boxf& window,
+                                                   const utils::Sizef& internalSize)
+    {
+      // Check degenerate cases.
+      if (m_referenceSize.w() <= 0.0f || m_referenceSize.h() <= 0.0f || m_referenceBoxes.size() != m_boxes.size()) {
+        return false;
+      }
 
-        // Check why we're out of the loop. There are two main scenarii:
-        // 1) we reached the end of the internal table.
-        // 2) a widget with the specified `role` has been found.
-        // The first scenario is cool because it means that there are no more widgets with
-        // the input `role` in this layout. We can exit the method.
-        // in the second case we need to remove the item we found and then start again.
+      const float sx = internalSize.w() / m_referenceSize.w();
+      const float sy = internalSize.h() / m_referenceSize.h();
 
-        if (info == m_infos.cend()) {
-          // All good.
-          stillWidgetWithRole = false;
+      for (unsigned id = 0u ; id < m_infos.valid.size() ; ++id) {
+        if (!m_infos.valid[id]) {
           continue;
         }
-        else {
-          // Remove the item we found.
-          removeItem(info->second.widget);
+
+        const WidgetRole& role = m_infos.roles[id];
+        const core::SdlWidget* widget = m_infos.widgets[id];
+        const utils::Boxf& ref = m_referenceBoxes[id];
+
+        // Scale the reference area around the center of the window.
+        const utils::Boxf scaled(
+          window.x() + (ref.x() - m_referenceWindow.x()) * sx,
+          window.y() + (ref.y() - m_referenceWindow.y()) * sy,
+          ref.w() * sx,
+          ref.h() * sy
+        );
+
+        // Hidden widgets are not considered by the internal layouts so they cannot
+        // invalidate the solution.
+        if (m_infos.visible[id]) {
+          const std::pair<bool, bool> manageDims = dimensionManagedForRole(role);
+          const utils::Sizef roleMax = computeMaxSizeForRole(internalSize, role);
+          const utils::Sizef min = widget->getMinSize();
+          const utils::Sizef hint = widget->getSizeHint();
+          const utils::Sizef max = widget->getMaxSize();
+
+          if (manageDims.first && !isScalable(ref.w(), scaled.w(), min.w(), hint.w(), std::min(max.w(), roleMax.w()), max.w())) {
+            m_logSink->log(m_logSource, AsyncLogSink::Level::Verbose, "Width of \"{}\" is constrained, falling back to full solve", widget->getName());
+            return false;
+          }
+
+          if (manageDims.second && !isScalable(ref.h(), scaled.h(), min.h(), hint.h(), std::min(max.h(), roleMax.h()), max.h())) {
+            m_logSink->log(m_logSource, AsyncLogSink::Level::Verbose, "Height of \"{}\" is constrained, falling back to full solve", widget->getName());
+            return false;
+          }
+        }
+
+        m_boxes[id] = scaled;
+      }
+
+      return true;
+    }
+
+    MainWindowLayout::CacheKey
+    MainWindowLayout::buildCacheKey(const utils::Boxf& window) const {
+      return CacheKey{
+        window,
+        m_infos.visible,
+        {
+          m_leftAreaPercentage,
+          m_rightAreaPercentage,
+          m_menuBarPercentage,
+          m_toolBarPercentage,
+          m_topAreaPercentage,
+          m_bottomAreaPercentage,
+          m_statusBarPercentage
+        }
+      };
+    }
+
+    bool
+    MainWindowLayout::fetchFromCache(const CacheKey& key) {
+      const std::lock_guard guard(m_cacheLocker);
+
+      // Traverse the cache: entries are sorted from the most recently used to the
+      // least recently used.
+      unsigned id = 0u;
+      while (id < m_cache.size() && !(m_cache[id].key == key)) {
+        ++id;
+      }
+
+      if (id >= m_cache.size()) {
+        ++m_cacheMisses;
+        return false;
+      }
+
+      ++m_cacheHits;
+
+      // Move the entry to the front of the cache.
+      std::rotate(m_cache.begin(), m_cache.begin() + id, m_cache.begin() + id + 1u);
+
+      const CacheEntry& entry = m_cache.front();
+      m_boxes = entry.boxes;
+
+      // In case the areas were obtained by solving the internal layouts, they can be
+      // used as a reference for subsequent resize operations.
+      if (entry.solved) {
+        m_referenceValid = true;
+        m_referenceWindow = key.window;
+        m_referenceSize = computeAvailableSize(key.window);
+        m_referenceBoxes = entry.boxes;
+      }
+
+      m_logSink->log(
+        m_logSource,
+        AsyncLogSink::Level::Verbose,
+        "Reusing {} area(s) from cache (hits: {}, misses: {})",
+        m_boxes.size(),
+        m_cacheHits,
+        m_cacheMisses
+      );
+
+      return true;
+    }
+
+    void
+    MainWindowLayout::saveToCache(const CacheKey& key,
+                                  bool solved)
+    {
+      const std::lock_guard guard(m_cacheLocker);
+
+      if (m_cacheCapacity == 0u) {
+        return;
+      }
+
+      // Evict the least recently used entry if needed and insert the new entry
+      // at the front of the cache.
+      if (m_cache.size() >= m_cacheCapacity) {
+        m_cache.resize(m_cacheCapacity - 1u);
+      }
+
+      m_cache.insert(m_cache.begin(), CacheEntry{key, m_boxes, solved});
+    }
+
+    void
+    MainWindowLayout::removeAll(const WidgetRole& role) {
+      // Traverse the internal table of content and remove each one which role matches
+      // the input value. We cannot rely on the index of the items to perform the removal
+      // as the indices of the items might change precisely because of the removal of other
+      // items. However the removal is performed based on the widget itself so we can first
+      // gather all the widgets to remove in a single pass and then remove them.
+      std::vector<core::SdlWidget*> toRemove;
+
+      for (unsigned id = 0u ; id < m_infos.valid.size() ; ++id) {
+        if (m_infos.valid[id] && m_infos.roles[id] == role) {
+          toRemove.push_back(m_infos.widgets[id]);
         }
       }
-      while (stillWidgetWithRole);
+
+      for (unsigned id = 0u ; id < toRemove.size() ; ++id) {
+        removeItem(toRemove[id]);
+      }
     }
 
     void
@@ -400,8 +656,7 @@ namespace sdl {
       }
 
       // Check that this item is registered in the information array.
-      InfosMap::const_iterator info = m_infos.find(id);
-      if (info == m_infos.cend()) {
+      if (!hasInfo(id)) {
         error(
           std::string("Cannot retrieve role for item \"") + widget->getName() + "\"",
           std::string("Inexisting key")
@@ -411,10 +666,10 @@ namespace sdl {
       // Check whether the role for this item is actually valid considering the
       // input `role`. In any other case we abort the deletion of the item as it
       // is not what is expected by the caller.
-      if (role != info->second.role) {
+      if (role != m_infos.roles[id]) {
         error(
           std::string("Could not remove item \"") + widget->getName() + "\" which is not a dock widget",
-          std::string("Role \"") + roleToName(info->second.role) + " does not match expected role \"" + roleToName(role)
+          std::string("Role \"") + roleToName(m_infos.roles[id]) + " does not match expected role \"" + roleToName(role)
         );
       }
 
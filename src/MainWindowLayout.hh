@@ -1,7 +1,14 @@
 #ifndef    MAIN_WINDOW_LAYOUT_HH
 # define   MAIN_WINDOW_LAYOUT_HH
 
+# include <array>
+# include <atomic>
+# include <cmath>
+# include <mutex>
+# include <cstdint>
 # include <memory>
+# include <algorithm>
+# include <vector>
 # include <unordered_map>
 # include <unordered_set>
 # include <maths_utils/Box.hh>
@@ -9,6 +16,8 @@
 # include <sdl_core/SizePolicy.hh>
 # include <sdl_graphic/GridLayout.hh>
 # include <sdl_graphic/VirtualLayoutItem.hh>
+# include "AsyncLogSink.hh"
+# include "Tracer.hh"
 # include "WidgetRole.hh"
 
 namespace sdl {
@@ -56,6 +65,18 @@ namespace sdl {
         void
         removeDockWidget(core::SdlWidget* item);
 
+        /**
+         * @brief - Starts a batch of modifications of this layout. No geometry will be
+         *          computed until the matching call to `endUpdate` which will trigger a
+         *          single recomputation if needed.
+         *          Batches can be nested.
+         */
+        void
+        beginUpdate() noexcept;
+
+        void
+        endUpdate();
+
         /**
          * @brief - Reimplementation of the `EngineObject` method which allows this
          *          class to not only register itself to the provided events queue
@@ -65,6 +86,56 @@ namespace sdl {
         void
         setEventsQueue(core::engine::EventsQueue* queue) noexcept override;
 
+        /**
+         * @brief - Describes the efficiency of the cache of areas used by this layout
+         *          to avoid solving the same configuration several times.
+         */
+        struct CacheStats {
+          std::uint64_t hits;
+          std::uint64_t misses;
+          std::size_t entries;
+          std::size_t capacity;
+        };
+
+        CacheStats
+        getCacheStats() noexcept;
+
+        /**
+         * @brief - Defines the maximum number of configurations kept in the cache of
+         *          this layout. A value of `0` disables the cache.
+         * @param capacity - the new capacity of the cache.
+         */
+        void
+        setCacheCapacity(std::size_t capacity) noexcept;
+
+        /**
+         * @brief - Retrieves the number of times this layout assigned new areas to
+         *          its widgets. It allows to detect that the layout changed since the
+         *          last time it was queried.
+         *          This method can be called from any thread and never waits for a
+         *          computation of the geometry.
+         * @return - the generation of the areas currently assigned to the widgets.
+         */
+        std::uint64_t
+        getGeneration() const noexcept;
+
+        /**
+         * @brief - Assigns the tracer used to record the computations of the geometry
+         *          of this layout. Use `null` to disable the tracing.
+         * @param tracer - the tracer to use.
+         */
+        void
+        setTracer(TracerShPtr tracer) noexcept;
+
+        /**
+         * @brief - Assigns the sink used to write the messages produced while the
+         *          geometry is computed. Use a sink which is not started to write
+         *          them synchronously, `null` restores the default such sink.
+         * @param sink - the sink to use.
+         */
+        void
+        setLogSink(AsyncLogSinkShPtr sink);
+
       protected:
 
         void
@@ -103,31 +174,143 @@ namespace sdl {
       private:
 
         /**
-         * @brief - Describes additional information to locate the widget
-         *          in the layout. Each data is linked to a widget which
-         *          is represented through the `widget` attribute. To get
-         *          the index of the item in the parent `m_items` table
-         *          one can use the `getIndexOf` method.
-         *          The role of the widget is specified using the `role`
-         *          attribute and according to the role the relevant area
-         *          is provided to locate the widget in the layout.
+         * @brief - Describes additional information to locate the widgets
+         *          in the layout. The information is stored as a set of
+         *          arrays indexed by the logical id of each item so that
+         *          traversing all the items is cache friendly. The `valid`
+         *          array indicates which logical ids are actually used.
+         *          Each entry is linked to a widget which is represented
+         *          through the `widgets` array. To get the index of the
+         *          item in the parent `m_items` table one can use the
+         *          `getIndexOf` method.
+         *          The role of the widget is specified using the `roles`
+         *          array and according to the role the relevant area is
+         *          provided to locate the widget in the layout.
          *          Note that if the role for the widget is not set to
-         *          `DockWidget` the `area` attribute is not relevant and
-         *          set to its default value, i.e. `None`.
+         *          `DockWidget` the area is not relevant and set to its
+         *          default value, i.e. `None`.
          *          Finally due to the way we handle the repartition of
          *          the widgets, we associate a virtual layout item to any
          *          new widget so that we can gather information from the
          *          internal layouts without polluting the real widgets
          *          with uneeded events.
+         *          The `visible` array keeps track of the visibility status
+         *          last assigned to the virtual items so that we can detect
+         *          which widgets changed since the last time the geometry
+         *          was computed.
+         *          Similarly the `constraints` array keeps track of the size
+         *          constraints of each widget last applied to its virtual
+         *          item: the widget may modify them at any time (e.g. when a
+         *          tab is inserted in a tab widget) which requires to solve
+         *          the internal layouts again.
          */
-        struct ItemInfo {
-          WidgetRole role;
-          DockWidgetArea area;
-          core::SdlWidget* widget;
-          graphic::VirtualLayoutItemShPtr item;
+        struct ItemsInfo {
+          std::vector<bool> valid;
+          std::vector<WidgetRole> roles;
+          std::vector<DockWidgetArea> areas;
+          std::vector<core::SdlWidget*> widgets;
+          std::vector<graphic::VirtualLayoutItemShPtr> items;
+          std::vector<bool> visible;
+          std::vector<core::Layout::WidgetInfo> constraints;
         };
 
-        using InfosMap = std::unordered_map<int, ItemInfo>;
+        /**
+         * @brief - Determines whether the size constraints described by the input
+         *          information are identical. The visibility is not considered.
+         * @param lhs - the first set of constraints.
+         * @param rhs - the second set of constraints.
+         * @return - `true` if both sets of constraints are identical.
+         */
+        static
+        bool
+        sameConstraints(const core::Layout::WidgetInfo& lhs,
+                        const core::Layout::WidgetInfo& rhs) noexcept;
+
+        /**
+         * @brief - Used to determine whether some information is registered for the
+         *          input logical id.
+         * @param logicID - the logical id to check.
+         * @return - `true` if the `m_infos` contain some data for this id.
+         */
+        bool
+        hasInfo(int logicID) const noexcept;
+
+        /**
+         * @brief - Registers the information for the item with the specified logical
+         *          id. The internal arrays are resized if needed.
+         * @param logicID - the logical id of the item.
+         * @param role - the role of the item.
+         * @param area - the area of the item.
+         * @param widget - the widget associated to the item.
+         * @param item - the virtual layout item representing the widget.
+         */
+        void
+        registerInfo(int logicID,
+                     const WidgetRole& role,
+                     const DockWidgetArea& area,
+                     core::SdlWidget* widget,
+                     graphic::VirtualLayoutItemShPtr item);
+
+        /**
+         * @brief - Removes the information registered for the input logical id. The
+         *          trailing unused entries of the internal arrays are released.
+         * @param logicID - the logical id to remove.
+         * @return - `true` if some information was registered for this id.
+         */
+        bool
+        unregisterInfo(int logicID);
+
+        /**
+         * @brief - Describes a configuration of the layout: the window in which it is
+         *          displayed, the visibility of each item and the percentages of each
+         *          area. Two identical configurations yield the same areas.
+         */
+        struct CacheKey {
+          utils::Boxf window;
+          std::vector<bool> visible;
+          std::array<float, 7u> percentages;
+
+          bool
+          operator==(const CacheKey& rhs) const noexcept;
+        };
+
+        /**
+         * @brief - An entry of the cache: along with the configuration we keep the
+         *          areas computed for each item. The `solved` boolean indicates that
+         *          the areas were obtained by solving the internal layouts and can
+         *          thus be used as a reference for resize operations.
+         */
+        struct CacheEntry {
+          CacheKey key;
+          std::vector<utils::Boxf> boxes;
+          bool solved;
+        };
+
+        CacheKey
+        buildCacheKey(const utils::Boxf& window) const;
+
+        /**
+         * @brief - Attempts to retrieve the areas for the input configuration from the
+         *          cache. In case of a hit, the `m_boxes` are updated and the entry is
+         *          marked as the most recently used.
+         * @param key - the configuration to search for.
+         * @return - `true` if the configuration was found in the cache.
+         */
+        bool
+        fetchFromCache(const CacheKey& key);
+
+        /**
+         * @brief - Saves the current `m_boxes` in the cache for the input configuration,
+         *          evicting the least recently used entry if needed.
+         * @param key - the configuration corresponding to the `m_boxes`.
+         * @param solved - `true` if the boxes were obtained by solving the layouts.
+         */
+        void
+        saveToCache(const CacheKey& key,
+                    bool solved);
+
+        void
+        clearCache() noexcept;
 
         /**
          * @brief - Remove all the widgets of this layout which are currently
@@ -143,6 +326,43 @@ namespace sdl {
         computeMaxSizeForRole(const utils::Sizef& window,
                               const WidgetRole& role) const;
 
+        /**
+         * @brief - Attempts to compute the areas of each widget by scaling the reference
+         *          solution to the new `window`. This is only possible when none of the
+         *          widgets is constrained by its own size bounds, in which case `false`
+         *          is returned and a complete solve is required.
+         *          The `m_boxes` are updated with the scaled areas.
+         * @param window - the window for which areas should be computed.
+         * @param internalSize - the size available for widgets in the `window`.
+         * @return - `true` if the areas could be derived from the reference solution.
+         */
+        bool
+        computeGeometryFromReference(const utils::Boxf& window,
+                                     const utils::Sizef& internalSize);
+
+        /**
+         * @brief - Used to determine whether a dimension of a widget can be scaled
+         *          from a reference solution. This is the case if the reference did
+         *          not use any bound of the widget (which would not be proportional
+         *          to the window's size) and if the scaled dimension is still within
+         *          the valid range for this widget.
+         * @param ref - the dimension in the reference solution.
+         * @param scaled - the dimension scaled to the new window.
+         * @param min - the minimum dimension of the widget.
+         * @param hint - the size hint of the widget along this dimension.
+         * @param upper - the maximum dimension allowed for the widget in the new window.
+         * @param max - the maximum dimension of the widget.
+         * @return - `true` if the scaled dimension can be used.
+         */
+        static
+        bool
+        isScalable(float ref,
+                   float scaled,
+                   float min,
+                   float hint,
+                   float upper,
+                   float max) noexcept;
+
         /**
          * @brief - Used to return a prefix which can be used to provide a name slightly
          *          different from the initial item name when creating a virtual layout
@@ -177,7 +397,7 @@ namespace sdl {
 
       private:
 
-        InfosMap m_infos;
+        ItemsInfo m_infos;
 
         /**
          * @brief - The main window layout is divided into three horizontal sections:
@@ -219,6 +439,74 @@ namespace sdl {
         graphic::GridLayout m_hLayout;
         graphic::GridLayout m_vLayout;
 
+        /**
+         * @brief - Describes the batches of modifications in progress for this layout.
+         *          The `m_updateDepth` counts the nested batches while the boolean
+         *          `m_geometryDeferred` indicates that a computation of the geometry
+         *          was requested during the batch.
+         *          Both are atomic as the geometry is computed in the events thread.
+         */
+        std::atomic<unsigned> m_updateDepth;
+        std::atomic_bool m_geometryDeferred;
+
+        /**
+         * @brief - Information about the last computation of the geometry. It is used to
+         *          only solve the internal layouts which are impacted by the modifications
+         *          since the last computation.
+         *          The `m_structureChanged` boolean indicates that some items were added or
+         *          removed from the layout while the `m_lastWindow` allows to detect changes
+         *          in the available space.
+         *          The `m_boxes` hold the areas assigned to each item during the previous
+         *          computation and are reused if nothing changed. Finally the boolean
+         *          `m_itemsStale` indicates that the areas were not computed through the
+         *          internal layouts and that the virtual items are thus out of date.
+         */
+        bool m_geometrySolved;
+        bool m_structureChanged;
+        utils::Boxf m_lastWindow;
+        std::vector<utils::Boxf> m_boxes;
+        bool m_itemsStale;
+
+        /**
+         * @brief - Describes the last solution computed by actually solving the internal
+         *          layouts. It is used when the window is resized to derive the areas of
+         *          the widgets without solving the layouts again.
+         *          The reference is invalidated as soon as the structure or the visibility
+         *          of widgets change.
+         */
+        bool m_referenceValid;
+        utils::Boxf m_referenceWindow;
+        utils::Sizef m_referenceSize;
+        std::vector<utils::Boxf> m_referenceBoxes;
+
+        /**
+         * @brief - Cache of the areas computed for the most recent configurations of
+         *          this layout. Entries are sorted from the most recently used to the
+         *          least recently used one. The cache is cleared whenever the structure
+         *          of the layout or the size constraints of a widget change.
+         */
+        std::mutex m_cacheLocker;
+        std::size_t m_cacheCapacity;
+        std::vector<CacheEntry> m_cache;
+        std::uint64_t m_cacheHits;
+        std::uint64_t m_cacheMisses;
+
+        /**
+         * @brief - Incremented in the events thread each time new areas are assigned
+         *          to the widgets and read by the rendering thread.
+         */
+        std::atomic<std::uint64_t> m_generation;
+
+        /**
+         * @brief - The `m_tracer` records the computations of the geometry while the
+         *          `m_logSink` writes the messages produced meanwhile. The layout uses
+         *          its own sink, which is not started and thus writes the messages
+         *          synchronously, until a sink is assigned.
+         */
+        TracerShPtr m_tracer;
+        AsyncLogSinkShPtr m_logSink;
+        AsyncLogSink::Source m_logSource;
+
     };
 
     using MainWindowLayoutShPtr = std::shared_ptr<MainWindowLayout>;
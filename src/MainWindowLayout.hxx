@@ -60,6 +60,29 @@ namespace sdl {
       removeItemFromRole(item, WidgetRole::ToolBar);
     }
 
+    inline
+    void
+    MainWindowLayout::beginUpdate() noexcept {
+      ++m_updateDepth;
+    }
+
+    inline
+    void
+    MainWindowLayout::endUpdate() {
+      if (m_updateDepth == 0u) {
+        error(
+          std::string("Could not end update of layout"),
+          std::string("No update in progress")
+        );
+      }
+
+      // Trigger the computation of the geometry in case it was requested
+      // during the batch.
+      if (--m_updateDepth == 0u && m_geometryDeferred.exchange(false)) {
+        invalidate();
+      }
+    }
+
     inline
     void
     MainWindowLayout::setEventsQueue(core::engine::EventsQueue* queue) noexcept {
@@ -71,19 +94,38 @@ namespace sdl {
       registerToSameQueue(&m_vLayout);
     }
 
+    inline
+    MainWindowLayout::CacheStats
+    MainWindowLayout::getCacheStats() noexcept {
+      const std::lock_guard guard(m_cacheLocker);
+      return CacheStats{m_cacheHits, m_cacheMisses, m_cache.size(), m_cacheCapacity};
+    }
+
+    inline
+    void
+    MainWindowLayout::setCacheCapacity(std::size_t capacity) noexcept {
+      const std::lock_guard guard(m_cacheLocker);
+
+      m_cacheCapacity = capacity;
+      if (m_cache.size() > m_cacheCapacity) {
+        m_cache.resize(m_cacheCapacity);
+      }
+    }
+
     inline
     bool
     MainWindowLayout::onIndexRemoved(int logicID,
                                      int /*physID*/)
     {
       // Erase the corresponding entry in the internal table.
-      const std::size_t count = m_infos.erase(logicID);
+      const bool removed = unregisterInfo(logicID);
+      m_structureChanged = true;
 
       // Check whether we could remove the input item.
-      if (count != 1) {
+      if (!removed) {
         warn(
           std::string("Invalid removed item count while deleting item ") + std::to_string(logicID) +
-          std::string("(removed ") + std::to_string(count) + " item(s))"
+          std::string("(removed 0 item(s))")
         );
       }
 
@@ -91,6 +133,127 @@ namespace sdl {
       return true;
     }
 
+    inline
+    bool
+    MainWindowLayout::hasInfo(int logicID) const noexcept {
+      return logicID >= 0 && logicID < static_cast<int>(m_infos.valid.size()) && m_infos.valid[logicID];
+    }
+
+    inline
+    void
+    MainWindowLayout::registerInfo(int logicID,
+                                   const WidgetRole& role,
+                                   const DockWidgetArea& area,
+                                   core::SdlWidget* widget,
+                                   graphic::VirtualLayoutItemShPtr item)
+    {
+      // Make room for the new item if needed.
+      if (logicID >= static_cast<int>(m_infos.valid.size())) {
+        const std::size_t size = logicID + 1u;
+
+        m_infos.valid.resize(size, false);
+        m_infos.roles.resize(size, WidgetRole::CentralDockWidget);
+        m_infos.areas.resize(size, DockWidgetArea::None);
+        m_infos.widgets.resize(size, nullptr);
+        m_infos.items.resize(size, nullptr);
+        m_infos.visible.resize(size, false);
+        m_infos.constraints.resize(size);
+      }
+
+      m_infos.valid[logicID] = true;
+      m_infos.roles[logicID] = role;
+      m_infos.areas[logicID] = area;
+      m_infos.widgets[logicID] = widget;
+      m_infos.items[logicID] = item;
+      m_infos.visible[logicID] = widget->isVisible();
+
+      // The virtual item is created with the current constraints of the widget.
+      core::Layout::WidgetInfo& constraints = m_infos.constraints[logicID];
+      constraints.policy = widget->getSizePolicy();
+      constraints.min = widget->getMinSize();
+      constraints.hint = widget->getSizeHint();
+      constraints.max = widget->getMaxSize();
+      constraints.visible = widget->isVisible();
+    }
+
+    inline
+    bool
+    MainWindowLayout::unregisterInfo(int logicID) {
+      if (!hasInfo(logicID)) {
+        return false;
+      }
+
+      m_infos.valid[logicID] = false;
+      m_infos.widgets[logicID] = nullptr;
+      m_infos.items[logicID].reset();
+
+      // Release trailing unused entries.
+      std::size_t size = m_infos.valid.size();
+      while (size > 0u && !m_infos.valid[size - 1u]) {
+        --size;
+      }
+
+      m_infos.valid.resize(size);
+      m_infos.roles.resize(size);
+      m_infos.areas.resize(size);
+      m_infos.widgets.resize(size);
+      m_infos.items.resize(size);
+      m_infos.visible.resize(size);
+      m_infos.constraints.resize(size);
+
+      return true;
+    }
+
+    inline
+    bool
+    MainWindowLayout::sameConstraints(const core::Layout::WidgetInfo& lhs,
+                                      const core::Layout::WidgetInfo& rhs) noexcept
+    {
+      return
+        lhs.policy == rhs.policy &&
+        lhs.min == rhs.min &&
+        lhs.hint == rhs.hint &&
+        lhs.max == rhs.max;
+    }
+
+    inline
+    bool
+    MainWindowLayout::CacheKey::operator==(const CacheKey& rhs) const noexcept {
+      return
+        window.x() == rhs.window.x() &&
+        window.y() == rhs.window.y() &&
+        window.w() == rhs.window.w() &&
+        window.h() == rhs.window.h() &&
+        visible == rhs.visible &&
+        percentages == rhs.percentages;
+    }
+
+    inline
+    void
+    MainWindowLayout::clearCache() noexcept {
+      const std::lock_guard guard(m_cacheLocker);
+      m_cache.clear();
+    }
+
+    inline
+    std::uint64_t
+    MainWindowLayout::getGeneration() const noexcept {
+      return m_generation.load();
+    }
+
+    inline
+    void
+    MainWindowLayout::setTracer(TracerShPtr tracer) noexcept {
+      m_tracer = tracer;
+    }
+
+    inline
+    void
+    MainWindowLayout::setLogSink(AsyncLogSinkShPtr sink) {
+      m_logSink = (sink != nullptr ? sink : std::make_shared<AsyncLogSink>());
+      m_logSource = m_logSink->registerSource(getName(), std::string("main_layout"));
+    }
+
     inline
     std::pair<bool, bool>
     MainWindowLayout::dimensionManagedForRole(const WidgetRole& role) const noexcept {
@@ -220,6 +383,31 @@ namespace sdl {
       return utils::Sizef(wMax, hMax);
     }
 
+    inline
+    bool
+    MainWindowLayout::isScalable(float ref,
+                                 float scaled,
+                                 float min,
+                                 float hint,
+                                 float upper,
+                                 float max) noexcept
+    {
+      // Tolerance used to compare dimensions, in pixels.
+      const float tolerance = 0.5f;
+
+      // Check whether the reference was bound by a size which does not depend on the
+      // window: in this case the solution is not proportional anymore.
+      if (std::abs(ref - min) < tolerance || std::abs(ref - max) < tolerance) {
+        return false;
+      }
+      if (hint > 0.0f && std::abs(ref - hint) < tolerance) {
+        return false;
+      }
+
+      // Check that the scaled dimension is valid.
+      return scaled >= min - tolerance && scaled <= upper + tolerance;
+    }
+
     inline
     std::string
     MainWindowLayout::getVirtualLayoutNamePrefix() noexcept {
@@ -285,12 +473,10 @@ namespace sdl {
 
       // Register this item in the internal table of information if a valid index
       // was generated.
-      m_infos[index] = ItemInfo{
-        role,
-        area,
-        widget,
-        item
-      };
+      registerInfo(index, role, area, widget, item);
+
+      // The internal layouts need to be solved again.
+      m_structureChanged = true;
     }
 
   }
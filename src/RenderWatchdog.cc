@@ -0,0 +1,152 @@
+
+# include "RenderWatchdog.hh"
+# include <algorithm>
+
+namespace sdl {
+  namespace app {
+
+    RenderWatchdog::RenderWatchdog():
+      utils::CoreObject(std::string("render_watchdog")),
+
+      m_origin(Clock::now()),
+
+      m_threshold(1000.0f),
+      m_skip(false),
+      m_retryInterval(60u),
+
+      m_stamp(0),
+      m_phase(nullptr),
+      m_area(nullptr),
+
+      m_stalls(0u),
+
+      m_suspended(),
+
+      m_locker(),
+      m_wakeup(),
+      m_running(false),
+      m_thread()
+    {
+      setService("watchdog");
+    }
+
+    void
+    RenderWatchdog::start() {
+      const std::lock_guard guard(m_locker);
+
+      if (m_running || getThreshold() <= 0.0f) {
+        return;
+      }
+
+      m_running = true;
+      m_thread = std::thread(&RenderWatchdog::monitor, this);
+    }
+
+    void
+    RenderWatchdog::stop() {
+      {
+        const std::lock_guard guard(m_locker);
+
+        if (!m_running) {
+          return;
+        }
+
+        m_running = false;
+      }
+
+      m_wakeup.notify_all();
+
+      if (m_thread.joinable()) {
+        m_thread.join();
+      }
+    }
+
+    void
+    RenderWatchdog::drawn(const core::SdlWidget* widget,
+                          const char* area,
+                          float duration,
+                          std::uint64_t frame)
+    {
+      const float threshold = getThreshold();
+      const bool slow = (threshold > 0.0f && duration >= threshold);
+
+      if (!slow) {
+        // Resume the widget if it was skipped.
+        if (!m_suspended.empty() && m_suspended.erase(widget) > 0u) {
+          notice(std::string("Resuming drawing of area \"") + area + "\" which recovered");
+        }
+
+        return;
+      }
+
+      if (!m_skip.load(std::memory_order_relaxed)) {
+        return;
+      }
+
+      const bool added = (m_suspended.count(widget) == 0u);
+      m_suspended[widget] = frame + m_retryInterval.load(std::memory_order_relaxed);
+
+      if (added) {
+        warn(
+          std::string("Skipping area \"") + area + "\" which took " + std::to_string(duration) +
+          "ms to draw, will retry every " + std::to_string(m_retryInterval.load(std::memory_order_relaxed)) + " frame(s)"
+        );
+      }
+    }
+
+    void
+    RenderWatchdog::monitor() {
+      std::int64_t stalled = 0;
+      const char* phase = nullptr;
+      const char* area = nullptr;
+
+      std::unique_lock guard(m_locker);
+
+      while (m_running) {
+        // Check the heartbeats a few times per threshold so that stalls are
+        // detected reasonably close to the threshold.
+        const float threshold = getThreshold();
+        const int period = std::max(1, static_cast<int>(threshold / 4.0f));
+
+        m_wakeup.wait_for(guard, std::chrono::milliseconds(period), [this]() { return !m_running; });
+
+        const std::int64_t stamp = m_stamp.load(std::memory_order_acquire);
+        const std::int64_t current = now();
+
+        // Report the end of a stall as soon as the rendering loop progressed.
+        if (stalled != 0 && stamp != stalled) {
+          notice(
+            std::string("Rendering loop resumed after stalling ") +
+            "in phase \"" + phase + "\"" + (area != nullptr ? std::string(" (area \"") + area + "\")" : std::string()) +
+            " for more than " + std::to_string((current - stalled) / 1000) + "ms"
+          );
+
+          stalled = 0;
+        }
+
+        if (stamp == 0 || stalled != 0 || threshold <= 0.0f) {
+          continue;
+        }
+
+        const float elapsed = (current - stamp) / 1000.0f;
+        if (elapsed < threshold) {
+          continue;
+        }
+
+        // The rendering loop did not progress for too long.
+        stalled = stamp;
+        phase = m_phase.load(std::memory_order_relaxed);
+        area = m_area.load(std::memory_order_relaxed);
+        phase = (phase != nullptr ? phase : "unknown");
+
+        m_stalls.fetch_add(1u, std::memory_order_relaxed);
+
+        warn(
+          std::string("Rendering loop stalled for ") + std::to_string(static_cast<int>(elapsed)) + "ms " +
+          "in phase \"" + phase + "\"" + (area != nullptr ? std::string(" (area \"") + area + "\")" : std::string())
+        );
+      }
+    }
+
+  }
+}
@@ -0,0 +1,177 @@
+#ifndef    RENDER_WATCHDOG_HH
+# define   RENDER_WATCHDOG_HH
+
+# include <mutex>
+# include <atomic>
+# include <chrono>
+# include <thread>
+# include <cstdint>
+# include <unordered_map>
+# include <condition_variable>
+# include <sdl_core/SdlWidget.hh>
+# include <core_utils/CoreObject.hh>
+
+namespace sdl {
+  namespace app {
+
+    /**
+     * @brief - Monitors the rendering loop from a dedicated thread. The loop
+     *          signals its progress through heartbeats indicating the phase
+     *          it is in and, while drawing, the top-level area being drawn.
+     *          When no heartbeat is received for longer than the threshold, a
+     *          stall is reported along with the phase and area which were last
+     *          active, and again once the loop resumes.
+     *          Optionally the widgets which took longer than the threshold to
+     *          draw are skipped on the next frames: they are only given a new
+     *          chance periodically and resume normally once they draw within
+     *          the threshold again.
+     */
+    class RenderWatchdog: public utils::CoreObject {
+      public:
+
+        using Clock = std::chrono::steady_clock;
+
+        RenderWatchdog();
+
+        virtual ~RenderWatchdog();
+
+        /**
+         * @brief - Defines the duration after which the rendering loop is
+         *          considered stalled. A negative or null value disables the
+         *          monitoring.
+         * @param threshold - the threshold in milliseconds.
+         */
+        void
+        setThreshold(float threshold) noexcept;
+
+        float
+        getThreshold() const noexcept;
+
+        /**
+         * @brief - Defines whether widgets exceeding the threshold should be
+         *          skipped and how often they should be given a new chance.
+         * @param skip - `true` if the widgets should be skipped.
+         * @param retryInterval - the number of frames between two attempts to
+         *                        draw a skipped widget.
+         */
+        void
+        setSkipStalled(bool skip,
+                       unsigned retryInterval = 60u) noexcept;
+
+        /**
+         * @brief - Starts the monitoring thread if the watchdog is enabled.
+         *          Nothing happens if it is already running.
+         */
+        void
+        start();
+
+        void
+        stop();
+
+        /**
+         * @brief - Signals that the rendering loop entered a new phase. This is
+         *          called by the rendering thread and is lock-free.
+         * @param phase - the name of the phase, which should be a literal.
+         * @param area - the name of the area being drawn if any, which should
+         *               also be a literal.
+         */
+        void
+        beat(const char* phase,
+             const char* area = nullptr) noexcept;
+
+        /**
+         * @brief - Indicates that the rendering loop is not running anymore so
+         *          that the lack of heartbeats is not reported as a stall.
+         */
+        void
+        idle() noexcept;
+
+        /**
+         * @brief - Determines whether the input widget should be drawn during
+         *          this frame. Should only be called by the rendering thread.
+         * @param widget - the widget to draw.
+         * @param frame - the index of the current frame.
+         * @return - `true` if the widget should be skipped.
+         */
+        bool
+        shouldSkip(const core::SdlWidget* widget,
+                   std::uint64_t frame);
+
+        /**
+         * @brief - Records the time taken to draw the input widget: it is used
+         *          to suspend widgets which exceed the threshold or to resume
+         *          those which recovered. Should only be called by the rendering
+         *          thread.
+         * @param widget - the widget which was drawn.
+         * @param area - the name of the area of the widget.
+         * @param duration - the time spent drawing the widget in milliseconds.
+         * @param frame - the index of the current frame.
+         */
+        void
+        drawn(const core::SdlWidget* widget,
+              const char* area,
+              float duration,
+              std::uint64_t frame);
+
+        /**
+         * @brief - Discards the information recorded for the input widget. This
+         *          should be called before a widget monitored by the watchdog is
+         *          destroyed so that a widget allocated later at the same address
+         *          does not inherit its state.
+         * @param widget - the widget to forget.
+         */
+        void
+        forget(const core::SdlWidget* widget);
+
+        std::uint64_t
+        getStallCount() const noexcept;
+
+      private:
+
+        /**
+         * @brief - Body of the monitoring thread.
+         */
+        void
+        monitor();
+
+        std::int64_t
+        now() const noexcept;
+
+      private:
+
+        Clock::time_point m_origin;
+
+        std::atomic<float> m_threshold;
+        std::atomic<bool> m_skip;
+        std::atomic<unsigned> m_retryInterval;
+
+        /**
+         * @brief - The last heartbeat: its timestamp in microseconds since the
+         *          `m_origin` (`0` when the loop is idle), the phase and the area
+         *          active at this moment.
+         */
+        std::atomic<std::int64_t> m_stamp;
+        std::atomic<const char*> m_phase;
+        std::atomic<const char*> m_area;
+
+        std::atomic<std::uint64_t> m_stalls;
+
+        /**
+         * @brief - Widgets currently skipped, associated to the frame at which
+         *          they should be drawn again. Only accessed by the rendering
+         *          thread or while the rendering is locked.
+         */
+        std::unordered_map<const core::SdlWidget*, std::uint64_t> m_suspended;
+
+        std::mutex m_locker;
+        std::condition_variable m_wakeup;
+        bool m_running;
+        std::thread m_thread;
+    };
+
+  }
+}
+
+# include "RenderWatchdog.hxx"
+
+#endif    /* RENDER_WATCHDOG_HH */
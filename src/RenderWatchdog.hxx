@@ -0,0 +1,96 @@
+#ifndef    RENDER_WATCHDOG_HXX
+# define   RENDER_WATCHDOG_HXX
+
+# include "RenderWatchdog.hh"
+
+namespace sdl {
+  namespace app {
+
+    inline
+    RenderWatchdog::~RenderWatchdog() {
+      stop();
+    }
+
+    inline
+    void
+    RenderWatchdog::setThreshold(float threshold) noexcept {
+      m_threshold.store(threshold, std::memory_order_relaxed);
+    }
+
+    inline
+    float
+    RenderWatchdog::getThreshold() const noexcept {
+      return m_threshold.load(std::memory_order_relaxed);
+    }
+
+    inline
+    void
+    RenderWatchdog::setSkipStalled(bool skip,
+                                   unsigned retryInterval) noexcept
+    {
+      m_retryInterval.store(std::max(1u, retryInterval), std::memory_order_relaxed);
+      m_skip.store(skip, std::memory_order_relaxed);
+    }
+
+    inline
+    void
+    RenderWatchdog::beat(const char* phase,
+                         const char* area) noexcept
+    {
+      m_phase.store(phase, std::memory_order_relaxed);
+      m_area.store(area, std::memory_order_relaxed);
+      m_stamp.store(now(), std::memory_order_release);
+    }
+
+    inline
+    void
+    RenderWatchdog::idle() noexcept {
+      m_stamp.store(0, std::memory_order_release);
+    }
+
+    inline
+    bool
+    RenderWatchdog::shouldSkip(const core::SdlWidget* widget,
+                               std::uint64_t frame)
+    {
+      if (m_suspended.empty()) {
+        return false;
+      }
+
+      std::unordered_map<const core::SdlWidget*, std::uint64_t>::iterator it = m_suspended.find(widget);
+      if (it == m_suspended.end()) {
+        return false;
+      }
+
+      // Give the widget a new chance periodically.
+      if (frame >= it->second) {
+        it->second = frame + m_retryInterval.load(std::memory_order_relaxed);
+        return false;
+      }
+
+      return true;
+    }
+
+    inline
+    void
+    RenderWatchdog::forget(const core::SdlWidget* widget) {
+      m_suspended.erase(widget);
+    }
+
+    inline
+    std::uint64_t
+    RenderWatchdog::getStallCount() const noexcept {
+      return m_stalls.load(std::memory_order_relaxed);
+    }
+
+    inline
+    std::int64_t
+    RenderWatchdog::now() const noexcept {
+      // Offset the timestamps so that `0` is never a valid heartbeat.
+      return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - m_origin).count() + 1;
+    }
+
+  }
+}
+
+#endif    /* RENDER_WATCHDOG_HXX */
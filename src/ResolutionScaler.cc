@@ -0,0 +1,62 @@
+
+# include "ResolutionScaler.hh"
+# include <cmath>
+
+namespace sdl {
+  namespace app {
+
+    ResolutionScaler::ResolutionScaler():
+      utils::CoreObject(std::string("resolution_scaler")),
+
+      m_enabled(false),
+      m_min(0.5f),
+      m_max(1.0f),
+      m_scale(1.0f),
+
+      m_average(0.0f),
+      m_cooldown(0u)
+    {
+      setService("render");
+    }
+
+    bool
+    ResolutionScaler::update(float duration,
+                             float budget)
+    {
+      if (!m_enabled || budget <= 0.0f) {
+        return false;
+      }
+
+      m_average = (m_average <= 0.0f ? duration : 0.9f * m_average + 0.1f * duration);
+
+      if (m_cooldown > 0u) {
+        --m_cooldown;
+        return false;
+      }
+
+      const float prev = m_scale;
+
+      if (m_average > sk_overload * budget) {
+        // The cost of a frame is roughly proportional to the number of pixels
+        // so we reduce the scale based on the ratio between the time spent and
+        // the available budget, without going too fast.
+        const float ratio = std::sqrt(sk_overload * budget / m_average);
+        m_scale = std::max(m_min, m_scale * std::max(0.75f, ratio));
+      }
+      else if (m_average < sk_headroom * budget) {
+        m_scale = std::min(m_max, m_scale * 1.05f);
+      }
+
+      if (m_scale == prev) {
+        return false;
+      }
+
+      m_cooldown = sk_cooldown;
+
+      verbose("Render scale changed from " + std::to_string(prev) + " to " + std::to_string(m_scale));
+
+      return true;
+    }
+
+  }
+}
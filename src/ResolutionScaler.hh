@@ -0,0 +1,95 @@
+#ifndef    RESOLUTION_SCALER_HH
+# define   RESOLUTION_SCALER_HH
+
+# include <memory>
+# include <core_utils/CoreObject.hh>
+
+namespace sdl {
+  namespace app {
+
+    /**
+     * @brief - Determines the scale at which the canvas of an application should
+     *          be rendered based on the measured frame times. The scale decreases
+     *          when frames exceed their budget and slowly recovers when there is
+     *          some headroom, always staying within the configured bounds.
+     *          A smoothed frame time is used along with a cooldown between two
+     *          changes so that isolated spikes do not cause the scale to oscillate.
+     */
+    class ResolutionScaler: public utils::CoreObject {
+      public:
+
+        ResolutionScaler();
+
+        virtual ~ResolutionScaler();
+
+        /**
+         * @brief - Activates or deactivates the dynamic scaling. When deactivated
+         *          the scale is reset to the upper bound.
+         * @param enabled - whether the scaling should be active.
+         */
+        void
+        setEnabled(bool enabled) noexcept;
+
+        bool
+        isEnabled() const noexcept;
+
+        /**
+         * @brief - Defines the bounds of the scale. Values are clamped to `]0; 1]`
+         *          and swapped if needed. The current scale is clamped to the new
+         *          bounds.
+         * @param min - the minimum scale of the canvas.
+         * @param max - the maximum scale of the canvas.
+         */
+        void
+        setBounds(float min,
+                  float max) noexcept;
+
+        float
+        getScale() const noexcept;
+
+        /**
+         * @brief - Accounts for a new frame and updates the scale if needed. The
+         *          scale is not modified when there is no budget left.
+         * @param duration - the time spent in the frame on the operations which
+         *                   depend on the scale, in milliseconds.
+         * @param budget - the time available for these operations in milliseconds.
+         * @return - `true` if the scale changed.
+         */
+        bool
+        update(float duration,
+               float budget);
+
+      private:
+
+        /**
+         * @brief - Describes the fraction of the budget above which the scale
+         *          is decreased, and the one under which it can be increased.
+         */
+        static constexpr float sk_overload = 0.95f;
+        static constexpr float sk_headroom = 0.7f;
+
+        /**
+         * @brief - Number of frames to wait after a change of the scale before
+         *          considering another one: this lets the smoothed frame time
+         *          reflect the new scale.
+         */
+        static constexpr unsigned sk_cooldown = 20u;
+
+      private:
+
+        bool m_enabled;
+        float m_min;
+        float m_max;
+        float m_scale;
+
+        float m_average;
+        unsigned m_cooldown;
+    };
+
+    using ResolutionScalerShPtr = std::shared_ptr<ResolutionScaler>;
+  }
+}
+
+# include "ResolutionScaler.hxx"
+
+#endif    /* RESOLUTION_SCALER_HH */
@@ -0,0 +1,49 @@
+#ifndef    RESOLUTION_SCALER_HXX
+# define   RESOLUTION_SCALER_HXX
+
+# include <algorithm>
+# include "ResolutionScaler.hh"
+
+namespace sdl {
+  namespace app {
+
+    inline
+    ResolutionScaler::~ResolutionScaler() {}
+
+    inline
+    void
+    ResolutionScaler::setEnabled(bool enabled) noexcept {
+      m_enabled = enabled;
+
+      m_scale = m_max;
+      m_average = 0.0f;
+      m_cooldown = 0u;
+    }
+
+    inline
+    bool
+    ResolutionScaler::isEnabled() const noexcept {
+      return m_enabled;
+    }
+
+    inline
+    void
+    ResolutionScaler::setBounds(float min,
+                                float max) noexcept
+    {
+      m_min = std::clamp(std::min(min, max), 0.1f, 1.0f);
+      m_max = std::clamp(std::max(min, max), 0.1f, 1.0f);
+
+      m_scale = std::clamp(m_scale, m_min, m_max);
+    }
+
+    inline
+    float
+    ResolutionScaler::getScale() const noexcept {
+      return m_scale;
+    }
+
+  }
+}
+
+#endif    /* RESOLUTION_SCALER_HXX */
@@ -1,6 +1,9 @@
 
 # include "SdlApplication.hh"
+# include <cmath>
 # include <thread>
+# include <algorithm>
+# include <SDL2/SDL.h>
 # include <core_utils/Chrono.hh>
 # include <sdl_engine/Color.hh>
 # include <sdl_engine/SdlEngine.hh>
@@ -17,19 +20,37 @@ namespace sdl {
                                    bool resizable,
                                    const utils::Sizef& centralSize,
                                    float framerate,
-                                   float eventsFramerate):
+                                   float eventsFramerate,
+                                   const PresentationMode& presentation):
       core::engine::EngineObject(name),
 
+      m_startup(),
+
       m_title(title),
 
       m_framerate(std::max(0.1f, framerate)),
       m_frameDuration(1000.0f / m_framerate),
+      m_frame(0u),
+
+      m_presentation(presentation),
+      m_refreshRate(0.0f),
+      m_presentDuration(0.0f),
 
       m_executionLocker(),
       m_renderingRunning(false),
 
       m_eventsDispatcher(nullptr),
       m_engine(nullptr),
+      m_systemEngine(nullptr),
+      m_recorder(),
+      m_tracer(std::make_shared<Tracer>()),
+      m_logSink(std::make_shared<AsyncLogSink>()),
+      m_logSource(m_logSink->registerSource(name, std::string("app"))),
+      m_systemEvents(),
+
+      m_tasks(),
+      m_tasksBudget(m_frameDuration / 4.0f),
+      m_idleTasks(),
 
       m_layout(nullptr),
 
@@ -42,12 +63,25 @@ namespace sdl {
       m_bottomArea(nullptr),
       m_statusBar(nullptr),
 
-      m_widgets(),
+      m_docks(),
+      m_freeDock(NoDockSlot),
+      m_windows(),
 
       m_renderLocker(),
+      m_updateDepth(0u),
+      m_updateOwner(),
+      m_layoutInvalidated(false),
       m_cachedSize(),
       m_window(),
-      m_canvas(),
+      m_watchdog(),
+      m_hiddenFrameDuration(250.0f),
+      m_renderScale(1.0f),
+      m_scaler(),
+      m_scaledDuration(0.0f),
+
+      m_governor(),
+      m_fullRepaint(true),
+      m_areasGeneration(0u),
       m_palette(core::engine::Palette::fromButtonColor(core::engine::Color::NamedColor::Cyan))
     {
       setService("app");
@@ -56,7 +90,9 @@ namespace sdl {
       create(size, eventsFramerate, resizable, centralSize);
 
       // Assign the desired icon.
+      m_startup.begin("set_icon");
       setIcon(icon);
+      m_startup.end();
     }
 
     void
@@ -103,10 +139,14 @@ namespace sdl {
       std::this_thread::sleep_for(std::chrono::milliseconds(100));
 
       // Notify that the rendering loop is now running.
+      m_tracer->setThreadName("main");
       startRendering();
+      m_watchdog.start();
 
       // While we are not asked to stop, continue rendering.
       bool stillRunning = true;
+      bool hidden = false;
+      bool mainHidden = false;
       while (stillRunning) {
 
         // Update running status and break if needed.
@@ -115,6 +155,43 @@ namespace sdl {
           break;
         }
 
+        // When no window is visible there's no point in rendering anything: we
+        // only keep fetching system events (so that we know when a window
+        // becomes visible again) and executing the tasks, at a low rate.
+        if (areAllWindowsHidden()) {
+          if (!hidden) {
+            notice("All windows are hidden, suspending rendering");
+            hidden = true;
+          }
+
+          fetchSystemEvents();
+          executeTasks();
+
+          // The watchdog should not consider the pause as a stall.
+          m_watchdog.idle();
+          std::this_thread::sleep_for(std::chrono::microseconds(static_cast<int>(m_hiddenFrameDuration.load() * 1000.0f)));
+
+          continue;
+        }
+
+        if (hidden) {
+          notice("Some windows are visible again, resuming rendering");
+          hidden = false;
+        }
+
+        // The main window is not repainted while it is hidden so the content of
+        // its canvas may be outdated when it is shown again: repaint everything.
+        const bool wasHidden = mainHidden;
+        mainHidden = isWindowHidden();
+
+        if (wasHidden && !mainHidden) {
+          const std::unique_lock guard = acquireRenderLocker();
+          m_fullRepaint = true;
+        }
+
+        const Tracer::Scope scope(m_tracer.get(), "main", "frame");
+        const IdleTasks::Clock::time_point frameStart = IdleTasks::Clock::now();
+
         // We need to perform the rendering to display the content of the window
         // to the user. Most APIs prevents GUI operations to be performed into the
         // main thread.
@@ -138,37 +215,104 @@ namespace sdl {
         // we only want to perform a certain amount of repaint every second.
         const float eventsPump = fetchSystemEvents();
 
+        // Execute the tasks which need to be run in the main thread, such as
+        // the creation of textures. Anything not executed within the budget
+        // will be handled on the next frame.
+        const float tasks = executeTasks();
+
         // Perform the copy of the offscreen canvas into the one displayed on screen.
+        // The first rendering is the last step of the start-up.
+        if (m_frame == 0u) {
+          m_startup.begin("first_render");
+        }
+
         const float frameDuration = renderCanvas();
 
+        if (m_frame == 0u) {
+          m_startup.complete();
+        }
+
+        ++m_frame;
+
+        // When the presentation is synchronized with the display, the time spent
+        // waiting for the vertical blank is not part of the work of the frame.
+        const float work = (m_presentation == PresentationMode::VSync ? std::max(0.0f, frameDuration - m_presentDuration) : frameDuration);
+
         // Check whether the rendering time is compatible with the desired framerate.
-        const float total = eventsPump + frameDuration;
-        if (total > m_frameDuration) {
-          // Log this problem.
-          warn(
-            std::string("Repaint took ") + std::to_string(frameDuration) + "ms " +
-            "which is greater than the " + std::to_string(m_frameDuration) + "ms " +
-            " authorized to maintain " + std::to_string(m_framerate) + "fps"
-          );
+        const float total = eventsPump + tasks + work;
+        const float budget = m_frameDuration;
+
+        // Adapt the resolution of the canvas to the load if needed. Only the
+        // composition and the presentation of the canvas depend on its scale:
+        // the scaler compares them to the budget left by the rest of the work
+        // so that it does not lower the scale in an attempt to compensate for
+        // slow widgets. The scaler can be reconfigured from other threads so
+        // we need the lock to use it.
+        {
+          const std::unique_lock guard = acquireRenderLocker();
+          const float unscaled = eventsPump + tasks + std::max(0.0f, work - m_scaledDuration);
+
+          if (m_scaler.update(m_scaledDuration, m_frameDuration - unscaled)) {
+            setRenderScale(m_scaler.getScale());
+          }
+        }
 
+        // Let the governor degrade the rendering in case of sustained overruns:
+        // it also takes care of reporting them periodically. As for the scaler
+        // it can be reconfigured from other threads.
+        {
+          const std::unique_lock guard = acquireRenderLocker();
+          if (m_governor.account(total, budget)) {
+            updateFrameDuration();
+          }
+        }
+
+        if (total > budget) {
           // Move on to the next frame.
           continue;
         }
 
+        // Rather than sleeping right away, use the time left in the frame to run
+        // the idle tasks. We keep a small margin so that they don't make us miss
+        // the next frame.
+        IdleTasks::Clock::time_point deadline = frameStart + std::chrono::microseconds(static_cast<int>(m_frameDuration * 1000.0f));
+        IdleTasks::Clock::time_point wakeup = deadline;
+
+        if (m_presentation == PresentationMode::VSync) {
+          // The frame was just presented on a vertical blank: the next one is
+          // expected `m_frameDuration` from now, provided that its work (which
+          // we estimate from the current frame) is done by then. When the cap
+          // is lower than the refresh rate, we only need to wake up after the
+          // last blank preceding the next presentation as the renderer blocks
+          // until the right one.
+          const IdleTasks::Clock::time_point now = IdleTasks::Clock::now();
+          const float interval = 1000.0f / m_refreshRate;
+
+          deadline = now + std::chrono::microseconds(static_cast<int>((m_frameDuration - total) * 1000.0f));
+          wakeup = now + std::chrono::microseconds(static_cast<int>((m_frameDuration - interval) * 1000.0f));
+        }
+
+        executeIdleTasks(deadline - std::chrono::milliseconds(1));
+
         // Sleep for the remaining time to complete a frame if there's enough time left.
-        const unsigned int remainingDuration = static_cast<unsigned>(m_frameDuration - frameDuration);
-        if (remainingDuration > 3u) {
-          std::this_thread::sleep_for(std::chrono::milliseconds(remainingDuration));
+        const auto remainingDuration = std::chrono::duration_cast<std::chrono::milliseconds>(wakeup - IdleTasks::Clock::now()).count();
+        if (remainingDuration > 3) {
+          const Tracer::Scope sleep(m_tracer.get(), "main", "sleep");
+          m_watchdog.beat("sleep");
+          std::this_thread::sleep_until(wakeup);
         }
       }
 
+      m_watchdog.idle();
+      m_watchdog.stop();
+
       notice("Exiting rendering thread");
     }
 
     void
     SdlApplication::setMenuBar(core::SdlWidget* item) {
       // Lock this app to prevent data races.
-      const std::lock_guard guard(m_renderLocker);
+      const std::unique_lock guard = acquireRenderLocker();
 
       // Share data with this widget.
       shareDataWithWidget(item);
@@ -182,6 +326,7 @@ namespace sdl {
       // forget to release memory used by previous
       // iterations.
       if (m_menuBar != nullptr) {
+        m_watchdog.forget(m_menuBar);
         delete m_menuBar;
       }
       m_menuBar = item;
@@ -190,7 +335,7 @@ namespace sdl {
     void
     SdlApplication::addToolBar(core::SdlWidget* item) {
       // Lock this app to prevent data races.
-      const std::lock_guard guard(m_renderLocker);
+      const std::unique_lock guard = acquireRenderLocker();
 
       // Share data with this widget.
       shareDataWithWidget(item);
@@ -199,12 +344,7 @@ namespace sdl {
       // tab widget. We should also set the tab widget to
       // visible if needed so that it gets space upon calling
       // the layout's recompute method.
-      if (m_toolBar == nullptr) {
-        error(
-          std::string("Could not add tool bar \"") + item->getName() + "\"",
-          std::string("Invalid tab widget")
-        );
-      }
+      createTabForArea(DockWidgetArea::None);
 
       m_toolBar->insertTab(m_toolBar->getTabsCount(), item);
 
@@ -216,15 +356,13 @@ namespace sdl {
       m_toolBar->setVisible(true);
 
       // Trigger a layout recomputation.
-      if (m_layout != nullptr) {
-        m_layout->invalidate();
-      }
+      invalidateLayout();
     }
 
     void
     SdlApplication::setCentralWidget(core::SdlWidget* item) {
       // Lock this app to prevent data races.
-      const std::lock_guard guard(m_renderLocker);
+      const std::unique_lock guard = acquireRenderLocker();
 
       // Share data with this widget.
       shareDataWithWidget(item);
@@ -238,18 +376,19 @@ namespace sdl {
       // forget to release memory used by previous
       // iterations.
       if (m_centralWidget != nullptr) {
+        m_watchdog.forget(m_centralWidget);
         delete m_centralWidget;
       }
       m_centralWidget = item;
     }
 
-    void
+    DockWidgetHandle
     SdlApplication::addDockWidget(core::SdlWidget* item,
                                   const DockWidgetArea& area,
                                   const std::string& title)
     {
       // Lock this app to prevent data races.
-      const std::lock_guard guard(m_renderLocker);
+      const std::unique_lock guard = acquireRenderLocker();
 
       // Share data with this widget.
       shareDataWithWidget(item);
@@ -258,14 +397,7 @@ namespace sdl {
       // tab widget. We should also set the tab widget to
       // visible if needed so that it gets space upon calling
       // the layout's recompute method.
-      graphic::TabWidget* tab = getTabFromArea(area);
-
-      if (tab == nullptr) {
-        error(
-          std::string("Could not add dock widget \"") + item->getName() + "\" as dock widget in area \"" + areaToName(area) + "\"",
-          std::string("Invalid tab widget")
-        );
-      }
+      graphic::TabWidget* tab = createTabForArea(area);
 
       tab->insertTab(tab->getTabsCount(), item, title);
 
@@ -277,17 +409,30 @@ namespace sdl {
       tab->setVisible(true);
 
       // Trigger a layout recomputation.
-      if (m_layout != nullptr) {
-        m_layout->invalidate();
+      invalidateLayout();
+
+      // Register the widget in a free slot if any or in a new one.
+      std::uint32_t index = m_freeDock;
+      if (index != NoDockSlot) {
+        m_freeDock = m_docks[index].nextFree;
+      }
+      else {
+        index = static_cast<std::uint32_t>(m_docks.size());
+        m_docks.push_back(DockSlot{nullptr, DockWidgetArea::None, 1u, NoDockSlot});
       }
 
-      m_widgets[item->getName()] = area;
+      DockSlot& slot = m_docks[index];
+      slot.widget = item;
+      slot.area = area;
+      slot.nextFree = NoDockSlot;
+
+      return DockWidgetHandle{index, slot.generation};
     }
 
     void
     SdlApplication::setStatusBar(core::SdlWidget* item) {
       // Lock this app to prevent data races.
-      const std::lock_guard guard(m_renderLocker);
+      const std::unique_lock guard = acquireRenderLocker();
 
       // Share data with this widget.
       shareDataWithWidget(item);
@@ -301,6 +446,7 @@ namespace sdl {
       // forget to release memory used by previous
       // iterations.
       if (m_statusBar != nullptr) {
+        m_watchdog.forget(m_statusBar);
         delete m_statusBar;
       }
       m_statusBar = item;
@@ -309,7 +455,7 @@ namespace sdl {
     void
     SdlApplication::removeToolBar(core::SdlWidget* item) {
       // Lock this app to prevent data races.
-      const std::lock_guard guard(m_renderLocker);
+      const std::unique_lock guard = acquireRenderLocker();
 
       if (item == nullptr) {
         error(
@@ -334,16 +480,34 @@ namespace sdl {
         m_toolBar->setVisible(false);
 
         // Trigger a layout recomputation.
-        if( m_layout != nullptr) {
-          m_layout->invalidate();
-        }
+        invalidateLayout();
+      }
+    }
+
+    void
+    SdlApplication::removeDockWidget(const DockWidgetHandle& handle) {
+      // Lock this app to prevent data races.
+      const std::unique_lock guard = acquireRenderLocker();
+
+      // Check that the handle still references a registered widget: the slot
+      // may have been released or reused since then.
+      if (handle.index >= m_docks.size() ||
+          m_docks[handle.index].widget == nullptr ||
+          m_docks[handle.index].generation != handle.generation)
+      {
+        error(
+          std::string("Could not remove dock widget ") + std::to_string(handle.index) + " from application",
+          std::string("Invalid or expired handle")
+        );
       }
+
+      removeDockSlot(handle.index);
     }
 
     void
     SdlApplication::removeDockWidget(core::SdlWidget* item) {
       // Lock this app to prevent data races.
-      const std::lock_guard guard(m_renderLocker);
+      const std::unique_lock guard = acquireRenderLocker();
 
       if (item == nullptr) {
         error(
@@ -354,20 +518,30 @@ namespace sdl {
 
       // We need to remove the dock widget from its associated area.
       // To do so we first need to retrieve it.
-      WidgetsMap::const_iterator area = m_widgets.find(item->getName());
-      if (area == m_widgets.cend()) {
-        error(
-          std::string("Could not remove dock widget \"") + item->getName() + "\" from application",
-          std::string("No such widget")
-        );
+      for (std::uint32_t index = 0u ; index < m_docks.size() ; ++index) {
+        if (m_docks[index].widget == item) {
+          removeDockSlot(index);
+          return;
+        }
       }
 
+      error(
+        std::string("Could not remove dock widget \"") + item->getName() + "\" from application",
+        std::string("No such widget")
+      );
+    }
+
+    void
+    SdlApplication::removeDockSlot(std::uint32_t index) {
+      DockSlot& slot = m_docks[index];
+      core::SdlWidget* item = slot.widget;
+
       // Now retrieve the tab associated to this area.
-      graphic::TabWidget* tab = getTabFromArea(area->second);
+      graphic::TabWidget* tab = getTabFromArea(slot.area);
 
       if (tab == nullptr) {
         error(
-          std::string("Could not add dock widget \"") + item->getName() + "\" as dock widget in area \"" + areaToName(area->second) + "\"",
+          std::string("Could not remove dock widget \"") + item->getName() + "\" from area \"" + areaToName(slot.area) + "\"",
           std::string("Invalid tab widget")
         );
       }
@@ -375,15 +549,66 @@ namespace sdl {
       // Remove the item from the tab widget.
       tab->removeTab(item);
 
+      // Release the slot: bumping the generation invalidates the handles which
+      // still reference it. The generation `0` is reserved for invalid handles.
+      slot.widget = nullptr;
+      slot.area = DockWidgetArea::None;
+      slot.generation = (slot.generation == 0xFFFFFFFFu ? 1u : slot.generation + 1u);
+      slot.nextFree = m_freeDock;
+      m_freeDock = index;
+
       // Hide the tab widget if needed.
       if (tab->getTabsCount() == 0) {
         tab->setVisible(false);
 
         // Trigger a layout recomputation.
-        if( m_layout != nullptr) {
-          m_layout->invalidate();
-        }
+        invalidateLayout();
+      }
+    }
+
+    AppWindowShPtr
+    SdlApplication::openWindow(const std::string& title,
+                               const utils::Sizei& size,
+                               bool resizable,
+                               const utils::Sizef& centralSize)
+    {
+      const std::unique_lock guard = acquireRenderLocker();
+
+      AppWindowShPtr window = std::make_shared<AppWindow>(
+        getName() + "_window_" + std::to_string(m_windows.size()),
+        title,
+        size,
+        resizable,
+        centralSize,
+        m_systemEngine,
+        m_palette
+      );
+
+      // Share the events pump of the application.
+      registerToSameQueue(window.get());
+      window->setTracer(m_tracer);
+      window->setLogSink(m_logSink);
+
+      m_windows.push_back(window);
+
+      return window;
+    }
+
+    void
+    SdlApplication::closeWindow(AppWindowShPtr window) {
+      const std::unique_lock guard = acquireRenderLocker();
+
+      std::vector<AppWindowShPtr>::iterator it = std::find(m_windows.begin(), m_windows.end(), window);
+      if (it == m_windows.end()) {
+        error(
+          std::string("Could not close window \"") + (window == nullptr ? std::string("null") : window->getTitle()) + "\"",
+          std::string("No such window")
+        );
       }
+
+      // The window and its resources are released from the main thread on the
+      // next frame.
+      window->requestClose();
     }
 
     void
@@ -392,19 +617,79 @@ namespace sdl {
                            bool resizable,
                            const utils::Sizef& centralSize)
     {
+      // The synchronization with the display is a property of the renderer: it
+      // has to be requested through a global hint before the window (and thus
+      // its renderer) is created. The previous value of the hint is restored
+      // right after so that only the renderer of the main window is affected.
+      const char* hint = SDL_GetHint(SDL_HINT_RENDER_VSYNC);
+      const bool hadHint = (hint != nullptr);
+      const std::string previousHint = (hadHint ? hint : "");
+
+      const auto restoreHint = [hadHint, &previousHint]() {
+        if (hadHint) {
+          SDL_SetHint(SDL_HINT_RENDER_VSYNC, previousHint.c_str());
+          return;
+        }
+
+# if SDL_VERSION_ATLEAST(2, 24, 0)
+        SDL_ResetHint(SDL_HINT_RENDER_VSYNC);
+# else
+        SDL_SetHint(SDL_HINT_RENDER_VSYNC, "0");
+# endif
+      };
+
+      if (m_presentation == PresentationMode::VSync) {
+        SDL_SetHint(SDL_HINT_RENDER_VSYNC, "1");
+      }
+
       // Create the engine to use to perform rendering.
+      m_startup.begin("sdl_engine");
       core::engine::SdlEngineShPtr engine = std::make_shared<core::engine::SdlEngine>();
 
       // Use the engine to create the window.
-      m_window = engine->createWindow(size, resizable, getTitle());
+      m_startup.begin("create_window");
+
+      try {
+        m_window = engine->createWindow(size, resizable, getTitle());
+      }
+      catch (...) {
+        if (m_presentation == PresentationMode::VSync) {
+          restoreHint();
+        }
+        throw;
+      }
+
+      if (m_presentation == PresentationMode::VSync) {
+        restoreHint();
+      }
 
       if (!m_window.valid()) {
         error(std::string("Could not create window with size " + size.toString()));
       }
 
+      // Query the refresh rate of the display to pace the frames. The engine does
+      // not expose the native window so we use the primary display.
+      if (m_presentation == PresentationMode::VSync) {
+        SDL_DisplayMode mode;
+        if (SDL_GetCurrentDisplayMode(0, &mode) == 0 && mode.refresh_rate > 0) {
+          m_refreshRate = mode.refresh_rate;
+        }
+        else {
+          warn("Could not determine refresh rate of the display, assuming 60Hz");
+          m_refreshRate = 60.0f;
+        }
+
+        updateFrameDuration();
+        notice(
+          "Presentation synchronized with " + std::to_string(m_refreshRate) + "Hz display " +
+          "(frame duration: " + std::to_string(m_frameDuration) + "ms)"
+        );
+      }
+
       // Create a basic canvas which will be used as basis for the rendering.
-      m_canvas = engine->createTexture(m_window, size.toType<float>(), core::engine::Palette::ColorRole::Background);
-      if (!m_canvas.valid()) {
+      m_startup.begin("create_texture");
+      const utils::Uuid canvas = engine->createTexture(m_window, size.toType<float>(), core::engine::Palette::ColorRole::Background);
+      if (!canvas.valid()) {
         error(std::string("Could not create window's canvas with size " + size.toString()));
       }
 
@@ -412,17 +697,27 @@ namespace sdl {
       m_cachedSize = utils::Boxf::fromSize(size, true);
 
       // Finally create the engine decorator which will use the newly created
-      // window and canvases.
-      m_engine = std::make_shared<AppDecorator>(engine, m_canvas, m_palette, m_window);
+      // window and canvases. It takes ownership of the canvas.
+      m_startup.begin("app_decorator");
+      m_systemEngine = engine;
+      m_engine = std::make_shared<AppDecorator>(engine, canvas, m_palette, m_window);
 
       // Create the event listener and register this application as listener.
+      m_startup.begin("events_dispatcher");
       m_eventsDispatcher = std::make_shared<core::engine::EventsDispatcher>(eventsFramerate, m_engine, true);
 
       // Set the queue for this application so that it can post events.
       setEventsQueue(m_eventsDispatcher.get());
 
-      // Trigger the `build` method so that dock widgets are created.
+      // The system events are dispatched to every listener: filtering the ones
+      // received by the application allows to know when the dispatcher is done
+      // with the events forwarded by the system events queue.
+      installEventFilter(this);
+
+      // Trigger the `build` method so that the layout is created.
+      m_startup.begin("build");
       build(centralSize);
+      m_startup.end();
     }
 
     void
@@ -430,102 +725,188 @@ namespace sdl {
       // Create the layout for this window and assign it.
       setLayout(std::make_shared<MainWindowLayout>(5.0f, centralSize));
 
-      // Create dock widget for relevant areas and add them to the
-      // layout as non visible items.
+      // The tab widgets holding the tool bars and the dock widgets are created
+      // lazily when the first widget is inserted in the corresponding area: this
+      // way applications only pay for the areas they actually use.
+    }
 
-      // Toolbar
-      m_toolBar = new graphic::TabWidget(
-        std::string("toolbar_tabwidget"),
-        nullptr,
-        graphic::TabWidget::TabPosition::North
-      );
-      shareDataWithWidget(m_toolBar);
-      m_toolBar->setVisible(false);
+    graphic::TabWidget*
+    SdlApplication::createTabForArea(const DockWidgetArea& area) {
+      // Check whether the tab widget for this area already exists.
+      graphic::TabWidget* tab = (area == DockWidgetArea::None ? m_toolBar : getTabFromArea(area));
+      if (tab != nullptr) {
+        return tab;
+      }
 
-      m_layout->addToolBar(m_toolBar);
+      // The tab widget needs to be inserted in the layout.
+      if (m_layout == nullptr) {
+        error(
+          std::string("Could not create tab widget for area \"") + areaToName(area) + "\"",
+          std::string("Invalid layout")
+        );
+      }
+
+      std::string name("toolbar_tabwidget");
+      switch (area) {
+        case DockWidgetArea::TopArea:
+          name = "top_dock_tabwidget";
+          break;
+        case DockWidgetArea::LeftArea:
+          name = "left_dock_tabwidget";
+          break;
+        case DockWidgetArea::RightArea:
+          name = "right_dock_tabwidget";
+          break;
+        case DockWidgetArea::BottomArea:
+          name = "bottom_dock_tabwidget";
+          break;
+        default:
+          break;
+      }
 
-      // Dock widgets for each area.
-      m_topArea = new graphic::TabWidget(
-        std::string("top_dock_tabwidget"),
+      tab = new graphic::TabWidget(
+        name,
         nullptr,
         graphic::TabWidget::TabPosition::North
       );
-      shareDataWithWidget(m_topArea);
-      m_topArea->setVisible(false);
+      shareDataWithWidget(tab);
 
-      m_layout->addDockWidget(m_topArea, DockWidgetArea::TopArea);
+      // The tab widget is hidden until some tabs are inserted.
+      tab->setVisible(false);
 
-      m_leftArea = new graphic::TabWidget(
-        std::string("left_dock_tabwidget"),
-        nullptr,
-        graphic::TabWidget::TabPosition::North
-      );
-      shareDataWithWidget(m_leftArea);
-      m_leftArea->setVisible(false);
+      switch (area) {
+        case DockWidgetArea::TopArea:
+          m_topArea = tab;
+          break;
+        case DockWidgetArea::LeftArea:
+          m_leftArea = tab;
+          break;
+        case DockWidgetArea::RightArea:
+          m_rightArea = tab;
+          break;
+        case DockWidgetArea::BottomArea:
+          m_bottomArea = tab;
+          break;
+        default:
+          m_toolBar = tab;
+          break;
+      }
 
-      m_layout->addDockWidget(m_leftArea, DockWidgetArea::LeftArea);
+      if (area == DockWidgetArea::None) {
+        m_layout->addToolBar(tab);
+      }
+      else {
+        m_layout->addDockWidget(tab, area);
+      }
 
-      m_rightArea = new graphic::TabWidget(
-        std::string("right_dock_tabwidget"),
-        nullptr,
-        graphic::TabWidget::TabPosition::North
-      );
-      shareDataWithWidget(m_rightArea);
-      m_rightArea->setVisible(false);
+      return tab;
+    }
 
-      m_layout->addDockWidget(m_rightArea, DockWidgetArea::RightArea);
+    void
+    SdlApplication::releaseClosedWindows() {
+      std::vector<AppWindowShPtr>::iterator it = m_windows.begin();
 
-      m_bottomArea = new graphic::TabWidget(
-        std::string("bottom_dock_tabwidget"),
-        nullptr,
-        graphic::TabWidget::TabPosition::North
-      );
-      shareDataWithWidget(m_bottomArea);
-      m_bottomArea->setVisible(false);
+      while (it != m_windows.end()) {
+        if (!(*it)->isCloseRequested()) {
+          ++it;
+          continue;
+        }
+
+        notice("Closing window \"" + (*it)->getTitle() + "\"");
+
+        // Stop dispatching events to this window.
+        (*it)->unregisterFromQueue();
+        it = m_windows.erase(it);
+      }
+    }
 
-      m_layout->addDockWidget(m_bottomArea, DockWidgetArea::BottomArea);
+    bool
+    SdlApplication::areAllWindowsHidden() {
+      if (!isWindowHidden()) {
+        return false;
+      }
 
+      // The additional windows are opened and closed from other threads.
+      const std::unique_lock guard = acquireRenderLocker();
+
+      for (unsigned id = 0u ; id < m_windows.size() ; ++id) {
+        if (!m_windows[id]->isHidden()) {
+          return false;
+        }
+      }
+
+      return true;
     }
 
     float
     SdlApplication::renderCanvas() {
       // Start time measurement as we have to measure the duration of
       // this function.
+      const Tracer::Scope scope(m_tracer.get(), "main", "render_canvas");
+      m_watchdog.beat("render_canvas");
       auto start = std::chrono::steady_clock::now();
 
       {
         // Acquire the lock protecting the canvas so that we can guarantee that no other
         // rendering will take place simultaneously.
-        const std::lock_guard guard(m_renderLocker);
+        const std::unique_lock guard = acquireRenderLocker();
 
         // Perform the rendering for the widgets registered as children of
-        // this application.
-
-        repaintEvent(
-          core::engine::PaintEvent(
-            m_cachedSize,
-            core::engine::update::Frame::Global,
-            this
-          )
-        );
+        // this application, unless the main window is not visible.
+        m_scaledDuration = 0.0f;
+
+        if (!isWindowHidden()) {
+          repaintEvent(
+            core::engine::PaintEvent(
+              m_cachedSize,
+              core::engine::update::Frame::Global,
+              this
+            )
+          );
+        }
+
+        // Present the visible additional windows in the same loop.
+        m_watchdog.beat("render_windows");
+        releaseClosedWindows();
+
+        for (unsigned id = 0u ; id < m_windows.size() ; ++id) {
+          if (!m_windows[id]->isHidden()) {
+            m_windows[id]->render(m_tracer.get());
+          }
+        }
       }
 
       // Compute the elapsed time and return it as a floating point value.
       auto end = std::chrono::steady_clock::now();
-      auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+      auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
 
-      auto nanoDuration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
-      verbose("Rendering took " + std::to_string(nanoDuration/1000) + "µs");
+      m_logSink->log(m_logSource, AsyncLogSink::Level::Verbose, "Rendering took {}µs", duration);
 
-      return static_cast<float>(duration);
+      return duration / 1000.0f;
+    }
+
+    void
+    SdlApplication::updateFrameDuration() noexcept {
+      const float framerate = m_framerate * m_governor.getFramerateFactor();
+
+      if (m_presentation != PresentationMode::VSync || m_refreshRate <= 0.0f) {
+        m_frameDuration = 1000.0f / framerate;
+        return;
+      }
+
+      // Frames can only be presented on a vertical blank: the cap is rounded to
+      // a whole number of refresh intervals.
+      const float divider = std::max(1.0f, std::round(m_refreshRate / framerate));
+      m_frameDuration = divider * 1000.0f / m_refreshRate;
     }
 
     bool
     SdlApplication::geometryUpdateEvent(const core::engine::Event& e) {
       // We need to handle the recomputation of the internal layout if any.
+      const Tracer::Scope scope(m_tracer.get(), "events", "geometry_update");
 
       // Acquire the lock on this application.
-      const std::lock_guard guard(m_renderLocker);
+      const std::unique_lock guard = acquireRenderLocker();
 
       // Assign the cached size to the internal layout if any.
       if (m_layout != nullptr) {
@@ -548,23 +929,41 @@ namespace sdl {
       std::shared_ptr<core::engine::Engine> engine = m_engine;
       utils::Sizef dims = m_cachedSize.toSize();
 
+      // When the rendering is degraded the peripheral areas are not repainted on
+      // each frame: their content is kept in the canvas and only the area of the
+      // central widget is cleared and drawn again. A full repaint is required as
+      // soon as the canvas or the layout changed.
+      const std::uint64_t generation = (m_layout != nullptr ? m_layout->getGeneration() : 0u);
+      const bool peripheral = m_fullRepaint || generation != m_areasGeneration || m_governor.shouldRepaintPeripheral(m_frame);
+
+      m_fullRepaint = false;
+      m_areasGeneration = generation;
+
       // Clear the window.
-      engine->clearWindow(m_window);
+      if (peripheral) {
+        engine->clearWindow(m_window);
+      }
+      else if (m_centralWidget != nullptr) {
+        // Only the central widget is repainted in this frame: the rest of the
+        // canvas keeps the content of the previous frames and the whole canvas
+        // is presented to the window.
+        m_engine->clearArea(m_engine->getCanvasArea(*m_centralWidget));
+      }
 
       // Draw each child widget.
-      if (m_menuBar != nullptr && m_menuBar->isVisible()) {
+      if (peripheral && m_menuBar != nullptr && m_menuBar->isVisible()) {
         drawWidget(m_menuBar);
       }
 
-      if (m_toolBar != nullptr && m_toolBar->isVisible()) {
+      if (peripheral && m_toolBar != nullptr && m_toolBar->isVisible()) {
         drawWidget(m_toolBar);
       }
 
-      if (m_topArea != nullptr && m_topArea->isVisible()) {
+      if (peripheral && m_topArea != nullptr && m_topArea->isVisible()) {
         drawWidget(m_topArea);
       }
 
-      if (m_leftArea != nullptr && m_leftArea->isVisible()) {
+      if (peripheral && m_leftArea != nullptr && m_leftArea->isVisible()) {
         drawWidget(m_leftArea);
       }
 
@@ -572,20 +971,35 @@ namespace sdl {
         drawWidget(m_centralWidget);
       }
 
-      if (m_rightArea != nullptr && m_rightArea->isVisible()) {
+      if (peripheral && m_rightArea != nullptr && m_rightArea->isVisible()) {
         drawWidget(m_rightArea);
       }
 
-      if (m_bottomArea != nullptr && m_bottomArea->isVisible()) {
+      if (peripheral && m_bottomArea != nullptr && m_bottomArea->isVisible()) {
         drawWidget(m_bottomArea);
       }
 
-      if (m_statusBar != nullptr && m_statusBar->isVisible()) {
+      if (peripheral && m_statusBar != nullptr && m_statusBar->isVisible()) {
         drawWidget(m_statusBar);
       }
 
       // Now render the content of the window and make it visible to the user.
-      engine->renderWindow(m_window);
+      {
+        const Tracer::Scope scope(m_tracer.get(), "main", "render_window");
+        m_watchdog.beat("render_window");
+        const auto start = std::chrono::steady_clock::now();
+
+        engine->renderWindow(m_window);
+
+        m_presentDuration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count() / 1000.0f;
+      }
+
+      // With vsync the presentation mostly consists in waiting for the vertical
+      // blank: it is not a cost which can be reduced by lowering the scale.
+      m_scaledDuration = m_engine->takeCompositionDuration();
+      if (m_presentation != PresentationMode::VSync) {
+        m_scaledDuration += m_presentDuration;
+      }
 
       // Use base handler to determine whether the event was recognized.
       return core::engine::EngineObject::repaintEvent(e);
@@ -600,6 +1014,11 @@ namespace sdl {
       // children in time.
       // Note that we will consider that the focus reason is a hover over case as
       // the mouse left (most likely through motion).
+      // Events related to the additional windows are handled by them.
+      if (!(e.getWindID() == m_window)) {
+        return core::engine::EngineObject::windowLeaveEvent(e);
+      }
+
       core::engine::FocusEvent::Reason focus = core::engine::FocusEvent::Reason::HoverFocus;
 
       if (m_menuBar != nullptr) {
@@ -642,10 +1061,15 @@ namespace sdl {
     SdlApplication::windowResizeEvent(const core::engine::WindowEvent& e) {
       // We need to handle the resize of the canvas, and possibly the size of the
       // inserted widgets.
+      // Events related to the additional windows are handled by them.
+      if (!(e.getWindID() == m_window)) {
+        return core::engine::EngineObject::windowResizeEvent(e);
+      }
+
       utils::Sizef size = e.getSize();
 
       // Acquire the lock on this application.
-      const std::lock_guard guard(m_renderLocker);
+      const std::unique_lock guard = acquireRenderLocker();
 
       // Check whether the size is actually different from the current one.
       if (size == m_cachedSize.toSize()) {
@@ -654,30 +1078,13 @@ namespace sdl {
         return core::engine::EngineObject::windowResizeEvent(e);
       }
 
-      // Update the size of the internal canvas if any.
-      if (m_canvas.valid()) {
-        m_engine->destroyTexture(m_canvas);
-        m_canvas.invalidate();
-      }
-
-      // Creata a new texture with the required dimensions.
-      m_canvas = m_engine->createTexture(m_window, size, core::engine::Palette::ColorRole::Background);
-      if (!m_canvas.valid()) {
-        error(std::string("Could not create window's canvas with size " + size.toString()));
-      }
-
-      // Assign the new canvas texture.
-      m_engine->setDrawingCanvas(m_canvas);
-
-      // Update the viewport of the renderer associated to this window.
-      m_engine->updateViewport(
-        m_window,
-        utils::Boxf(size.w() / 2.0f, size.h() / 2.0f, size.w(), size.h())
-      );
-
       // Assign the cached size.
       m_cachedSize = utils::Boxf::fromSize(size);
 
+      // Create a new canvas with the required dimensions, taking into account
+      // the current render scale: this also updates the viewport of the window.
+      setRenderScale(m_renderScale);
+
       // And request an update of the layout.
       invalidate();
 
@@ -685,30 +1092,88 @@ namespace sdl {
       return core::engine::EngineObject::windowResizeEvent(e);
     }
 
+    bool
+    SdlApplication::windowShowEvent(const core::engine::WindowEvent& e) {
+      // Events related to the additional windows are handled by them.
+      if (e.getWindID() == m_window && m_engine != nullptr) {
+        m_engine->setWindowHidden(false);
+      }
+
+      return core::engine::EngineObject::windowShowEvent(e);
+    }
+
+    bool
+    SdlApplication::windowHideEvent(const core::engine::WindowEvent& e) {
+      if (e.getWindID() == m_window && m_engine != nullptr) {
+        m_engine->setWindowHidden(true);
+      }
+
+      return core::engine::EngineObject::windowHideEvent(e);
+    }
+
+    void
+    SdlApplication::setRenderScale(float scale) {
+      // The canvas is stretched to the size of the window when presented.
+      m_engine->resizeCanvas(m_cachedSize.toSize(), scale);
+
+      m_renderScale = scale;
+      m_fullRepaint = true;
+    }
+
     void
     SdlApplication::drawWidget(core::SdlWidget* widget) {
-      // Retrieve drawing variables.
-      std::shared_ptr<core::engine::Engine> engine = m_engine;
-      const utils::Sizef dims = m_cachedSize.toSize();
+      // Skip widgets which were detected as stalling the rendering until they
+      // recover.
+      if (m_watchdog.shouldSkip(widget, m_frame)) {
+        return;
+      }
+
+      const char* area = getAreaName(widget);
+
+      m_watchdog.beat("draw", area);
+      const auto start = std::chrono::steady_clock::now();
 
       // Surround with safety net and proceed to draw the widget.
+      const Tracer::Scope scope(m_tracer.get(), "draw", widget->getName());
       withSafetyNet(
-        [widget, engine, &dims]() {
-          utils::Uuid texture = widget->draw();
-          utils::Boxf render = widget->getDrawingArea();
-
-          render.x() += (dims.w() / 2.0f);
-          render.y() = (dims.h() / 2.0f) - render.y();
-
-          engine->drawTexture(
-            texture,
-            nullptr,
-            nullptr,
-            &render
-          );
+        [this, widget]() {
+          m_engine->drawWidget(*widget);
         },
         std::string("drawWidget(") + widget->getName() + ")"
        );
+
+      const float duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count() / 1000.0f;
+      m_watchdog.drawn(widget, area, duration, m_frame);
+    }
+
+    const char*
+    SdlApplication::getAreaName(const core::SdlWidget* widget) const noexcept {
+      if (widget == m_menuBar) {
+        return "menu_bar";
+      }
+      if (widget == m_toolBar) {
+        return "tool_bar";
+      }
+      if (widget == m_topArea) {
+        return "top_area";
+      }
+      if (widget == m_leftArea) {
+        return "left_area";
+      }
+      if (widget == m_rightArea) {
+        return "right_area";
+      }
+      if (widget == m_centralWidget) {
+        return "central_widget";
+      }
+      if (widget == m_bottomArea) {
+        return "bottom_area";
+      }
+      if (widget == m_statusBar) {
+        return "status_bar";
+      }
+
+      return "widget";
     }
 
   }
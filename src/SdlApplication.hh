@@ -2,9 +2,10 @@
 # define   SDL_APPLICATION_HH
 
 # include <mutex>
+# include <atomic>
 # include <thread>
 # include <memory>
-# include <unordered_map>
+# include <vector>
 # include <maths_utils/Box.hh>
 # include <maths_utils/Size.hh>
 # include <sdl_core/SdlWidget.hh>
@@ -14,14 +15,65 @@
 # include <sdl_engine/EventsDispatcher.hh>
 # include <sdl_graphic/TabWidget.hh>
 # include "AppDecorator.hh"
+# include "AppWindow.hh"
+# include "AsyncLogSink.hh"
+# include "DockWidgetHandle.hh"
+# include "EventsRecorder.hh"
+# include "FrameGovernor.hh"
 # include "MainWindowLayout.hh"
+# include "RenderWatchdog.hh"
+# include "ResolutionScaler.hh"
+# include "StartupTimeline.hh"
+# include "SystemEventsQueue.hh"
+# include "IdleTasks.hh"
+# include "TasksQueue.hh"
+# include "Tracer.hh"
 
 namespace sdl {
   namespace app {
 
+    /**
+     * @brief - Describes how the frames are paced by the rendering loop:
+     *          - `Paced` lets the loop sleep for the time left in each frame
+     *            so that the desired framerate is reached.
+     *          - `VSync` enables the synchronization of the renderer with the
+     *            refresh of the display: the presentation of a frame blocks
+     *            until the next vertical blank and the loop does not sleep by
+     *            itself. The desired framerate is then only used as a cap.
+     */
+    enum class PresentationMode {
+      Paced,
+      VSync
+    };
+
     class SdlApplication : public core::engine::EngineObject {
       public:
 
+        /**
+         * @brief - Convenience class starting a batch of modifications of the
+         *          application when created and ending it when destroyed. This
+         *          is the preferred way to batch modifications as the batch is
+         *          ended (and the application unlocked) even if an exception is
+         *          raised while it is in progress.
+         */
+        class UpdateBatch {
+          public:
+
+            explicit
+            UpdateBatch(SdlApplication& app);
+
+            ~UpdateBatch();
+
+            UpdateBatch(const UpdateBatch&) = delete;
+
+            UpdateBatch&
+            operator=(const UpdateBatch&) = delete;
+
+          private:
+
+            SdlApplication& m_app;
+        };
+
         explicit
         SdlApplication(const std::string& name,
                        const std::string& title,
@@ -30,7 +82,8 @@ namespace sdl {
                        bool resizable = true,
                        const utils::Sizef& centralSize = utils::Sizef(0.7f, 0.5f),
                        float framerate = 60.0f,
-                       float eventsFramerate = 30.0f);
+                       float eventsFramerate = 30.0f,
+                       const PresentationMode& presentation = PresentationMode::Paced);
 
         virtual ~SdlApplication();
 
@@ -43,6 +96,13 @@ namespace sdl {
         void
         run();
 
+        /**
+         * @brief - Requests the rendering loop started by `run` to stop after the
+         *          current frame. This method can be called from any thread.
+         */
+        void
+        quit();
+
         void
         setMenuBar(core::SdlWidget* item);
 
@@ -52,7 +112,14 @@ namespace sdl {
         void
         setCentralWidget(core::SdlWidget* item);
 
-        void
+        /**
+         * @brief - Inserts the input widget as a dock widget in the specified area.
+         * @param item - the widget to insert.
+         * @param area - the area in which the widget should be inserted.
+         * @param title - the title of the tab displaying the widget.
+         * @return - a handle which can be used to remove the widget.
+         */
+        DockWidgetHandle
         addDockWidget(core::SdlWidget* item,
                       const DockWidgetArea& area,
                       const std::string& title = std::string());
@@ -63,9 +130,325 @@ namespace sdl {
         void
         removeToolBar(core::SdlWidget* item);
 
+        /**
+         * @brief - Removes the dock widget referenced by the input handle. An
+         *          error is raised if the handle does not reference a widget
+         *          currently registered in the application.
+         * @param handle - the handle returned when the widget was added.
+         */
+        void
+        removeDockWidget(const DockWidgetHandle& handle);
+
+        /**
+         * @brief - Removes the input dock widget. Prefer the version using the
+         *          handle of the widget: this one needs to scan the registered
+         *          dock widgets to find it.
+         * @param item - the widget to remove.
+         */
         void
         removeDockWidget(core::SdlWidget* item);
 
+        /**
+         * @brief - Opens an additional window managed by this application. The window
+         *          has its own canvas and layout but shares the engine, the events pump
+         *          and the rendering loop of the application: it is presented on each
+         *          frame right after the main window.
+         *          This method must be called from the main thread.
+         * @param title - the title of the window.
+         * @param size - the initial size of the window.
+         * @param resizable - whether the window can be resized.
+         * @param centralSize - the percentage of the area occupied by the central
+         *                      widget along each axis.
+         * @return - the window which can be populated with widgets.
+         */
+        AppWindowShPtr
+        openWindow(const std::string& title,
+                   const utils::Sizei& size = utils::Sizei(640, 480),
+                   bool resizable = true,
+                   const utils::Sizef& centralSize = utils::Sizef(0.7f, 0.5f));
+
+        /**
+         * @brief - Closes a window opened with `openWindow`. This method can be
+         *          called from any thread: the window is only marked as closed and
+         *          released by the main thread on the next frame, like the windows
+         *          closed by the user. It is destroyed as soon as no other reference
+         *          to it exists.
+         * @param window - the window to close.
+         */
+        void
+        closeWindow(AppWindowShPtr window);
+
+        /**
+         * @brief - Starts a batch of modifications of the widgets of this application.
+         *          Until the matching call to `endUpdate`, the application stays locked
+         *          for the calling thread (which prevents rendering) and modifications
+         *          do not trigger any recomputation of the layout: it is performed once
+         *          when the batch ends.
+         *          Batches can be nested in which case only the outermost `endUpdate`
+         *          has an effect.
+         *          Prefer using an `UpdateBatch` which guarantees that the batch is
+         *          ended in case of an exception.
+         */
+        void
+        beginUpdate();
+
+        /**
+         * @brief - Ends a batch of modifications started with `beginUpdate`. Must be
+         *          called from the same thread as `beginUpdate`: an error is raised
+         *          if the calling thread did not start a batch.
+         */
+        void
+        endUpdate();
+
+        /**
+         * @brief - Starts recording the system events fetched by this application
+         *          into the specified `file`. Each event is saved along with the
+         *          frame it arrived in and a timestamp so that it can be replayed
+         *          later on through `replayEvents`.
+         * @param file - the path to the file where the trace should be saved.
+         */
+        void
+        recordEvents(const std::string& file);
+
+        /**
+         * @brief - Replays the events saved in the trace `file` as if they were
+         *          coming from the system. User input is discarded as long as the
+         *          replay is active.
+         * @param file - the path to the trace to replay.
+         * @param timing - whether the events should be replayed with the original
+         *                 timing or as fast as possible (one recorded frame at a
+         *                 time).
+         */
+        void
+        replayEvents(const std::string& file,
+                     const EventsRecorder::ReplayTiming& timing = EventsRecorder::ReplayTiming::Original);
+
+        /**
+         * @brief - Stops any recording or replay of system events.
+         */
+        void
+        stopEventsTrace();
+
+        /**
+         * @brief - Starts recording the activity of the rendering loop and of the
+         *          events thread (drawing of widgets, computation of the layout,
+         *          waits on the rendering locker, etc.). Spans recorded by a
+         *          previous session are discarded.
+         */
+        void
+        startTracing();
+
+        void
+        stopTracing();
+
+        /**
+         * @brief - Writes the spans recorded so far to the input `file` using the
+         *          Chrome Trace Event format, which can be opened in Perfetto or in
+         *          `chrome://tracing`.
+         * @param file - the path to the file where the trace should be saved.
+         */
+        void
+        dumpTrace(const std::string& file);
+
+        /**
+         * @brief - Moves the writing of the messages produced by the rendering loop
+         *          and by the layout to a background thread so that a slow output
+         *          does not impact the frame time. Messages which cannot be queued
+         *          are dropped and reported once the background thread catches up.
+         */
+        void
+        startAsyncLogging();
+
+        /**
+         * @brief - Writes the pending messages and goes back to a synchronous
+         *          logging.
+         */
+        void
+        stopAsyncLogging();
+
+        /**
+         * @brief - Returns the number of messages which were dropped because the
+         *          asynchronous sink was full.
+         * @return - the number of dropped messages.
+         */
+        std::uint64_t
+        getDroppedLogCount() const noexcept;
+
+        /**
+         * @brief - Configures the watchdog monitoring the rendering loop (see the
+         *          `RenderWatchdog` class). By default stalls longer than a second
+         *          are reported but no widget is skipped.
+         * @param threshold - the duration in milliseconds after which the loop is
+         *                    considered stalled. A negative or null value disables
+         *                    the watchdog.
+         * @param skipStalled - whether top-level widgets exceeding the threshold
+         *                      should be skipped until they recover.
+         * @param retryInterval - the number of frames between two attempts to draw
+         *                        a skipped widget.
+         */
+        void
+        setWatchdog(float threshold,
+                    bool skipStalled = false,
+                    unsigned retryInterval = 60u);
+
+        std::uint64_t
+        getStallCount() const noexcept;
+
+        /**
+         * @brief - Defines the rate at which system events are fetched while the
+         *          main window and all the additional windows are hidden or
+         *          minimized. No rendering happens at all in this case.
+         * @param rate - the rate in Hz.
+         */
+        void
+        setHiddenEventsRate(float rate);
+
+        /**
+         * @brief - Whether the main window is hidden or minimized. The additional
+         *          windows are tracked individually and still rendered when they
+         *          are visible.
+         * @return - `true` if the main window is not visible.
+         */
+        bool
+        isWindowHidden() const noexcept;
+
+        /**
+         * @brief - Defines the limits of the queue buffering the system events
+         *          before they are forwarded to the events dispatcher.
+         * @param capacity - the number of events which can be buffered, counting
+         *                   the ones not yet processed by the dispatcher, before
+         *                   stale motion events start being dropped.
+         * @param batch - the maximum number of events forwarded to the events
+         *                dispatcher on each frame, `0` for no limit other than
+         *                the capacity.
+         */
+        void
+        setEventsQueueLimits(std::size_t capacity,
+                             std::size_t batch);
+
+        /**
+         * @brief - Returns the current depth and the drop counters of the queue
+         *          buffering system events.
+         * @return - the metrics of the system events queue.
+         */
+        SystemEventsQueue::Metrics
+        getEventsQueueMetrics();
+
+        /**
+         * @brief - Returns the duration of each phase of the start-up of this
+         *          application, from the creation of the engine to the first
+         *          rendering of the canvas.
+         * @return - the phases of the start-up in chronological order.
+         */
+        std::vector<StartupTimeline::Phase>
+        getStartupTimeline();
+
+        /**
+         * @brief - Returns the start-up timeline serialized in JSON format along
+         *          with the total duration and the slowest phase.
+         * @return - the start-up report.
+         */
+        std::string
+        getStartupReport();
+
+        /**
+         * @brief - Registers a task to be executed on the main thread. This is
+         *          typically useful for operations which need to interact with
+         *          the rendering API such as creating or updating textures.
+         *          Tasks are executed at the beginning of each frame, after the
+         *          system events have been fetched and before the rendering. In
+         *          case the tasks exceed the budget allocated for them they are
+         *          carried over to the next frame.
+         *          This method can be called from any thread.
+         * @param task - the task to execute.
+         */
+        void
+        postTask(TasksQueue::Task task);
+
+        /**
+         * @brief - Defines the time allocated on each frame to the execution of
+         *          the tasks registered through `postTask`.
+         * @param budget - the budget for tasks, in milliseconds.
+         */
+        void
+        setTasksBudget(float budget) noexcept;
+
+        /**
+         * @brief - Activates the dynamic resolution mode: when frames exceed their
+         *          budget the canvas is rendered at a reduced scale and stretched to
+         *          the size of the window when presented. The scale recovers when
+         *          frames are fast enough again.
+         *          Note that the widgets keep their own resolution: only the canvas
+         *          they are composed on is scaled.
+         * @param enabled - whether the dynamic resolution should be active.
+         * @param minScale - the minimum scale of the canvas.
+         * @param maxScale - the maximum scale of the canvas.
+         */
+        void
+        setDynamicResolution(bool enabled,
+                             float minScale = 0.5f,
+                             float maxScale = 1.0f);
+
+        float
+        getRenderScale();
+
+        PresentationMode
+        getPresentationMode() const noexcept;
+
+        /**
+         * @brief - Returns the refresh rate of the display as queried when the
+         *          application was created. This value is only queried when the
+         *          presentation is synchronized with the display.
+         * @return - the refresh rate of the display in Hz or `0` if it is not
+         *           known.
+         */
+        float
+        getRefreshRate() const noexcept;
+
+        /**
+         * @brief - Activates the degradation of the rendering when frames consistently
+         *          exceed their budget (see `FrameGovernor`). It is disabled by default
+         *          in which case the overruns are only reported.
+         * @param enabled - whether the rendering can be degraded.
+         */
+        void
+        setFrameDegradation(bool enabled);
+
+        /**
+         * @brief - Defines the degradation steps applied when frames consistently
+         *          exceed their budget, once the degradation is activated.
+         * @param steps - the degradation steps, from the mildest to the harshest.
+         */
+        void
+        setDegradationSteps(const std::vector<FrameGovernor::Step>& steps);
+
+        /**
+         * @brief - Defines the interval between two summaries of the frames which
+         *          exceeded their budget.
+         * @param interval - the interval in milliseconds.
+         */
+        void
+        setOverrunSummaryInterval(float interval);
+
+        unsigned
+        getDegradationLevel();
+
+        /**
+         * @brief - Registers a low priority task to be executed in the main thread
+         *          whenever a frame completes early. Idle tasks are called as long
+         *          as there is some time left before the next frame and are meant
+         *          for opportunistic work such as warming caches or releasing some
+         *          unused resources.
+         *          This method can be called from any thread.
+         * @param task - the idle task to register.
+         * @return - an identifier which can be used to remove the task.
+         */
+        unsigned
+        addIdleTask(IdleTasks::Task task);
+
+        void
+        removeIdleTask(unsigned id);
+
       private:
 
         void
@@ -91,12 +474,32 @@ namespace sdl {
         graphic::TabWidget*
         getTabFromArea(const DockWidgetArea& area);
 
+        /**
+         * @brief - Returns the tab widget corresponding to the input `area`, creating
+         *          it and inserting it in the layout if it does not exist yet. Using
+         *          `DockWidgetArea::None` refers to the tab widget holding tool bars.
+         *          Assumes that the `m_renderLocker` is already acquired.
+         * @param area - the area for which the tab widget should be returned.
+         * @return - the tab widget corresponding to the input `area`.
+         */
+        graphic::TabWidget*
+        createTabForArea(const DockWidgetArea& area);
+
         void
         setLayout(MainWindowLayoutShPtr layout);
 
         void
         invalidate();
 
+        /**
+         * @brief - Requests a recomputation of the layout of this application. If a
+         *          batch of modifications is in progress the recomputation is delayed
+         *          until the end of the batch.
+         *          Assumes that the `m_renderLocker` is already acquired.
+         */
+        void
+        invalidateLayout();
+
         void
         stop();
 
@@ -120,11 +523,10 @@ namespace sdl {
                const utils::Sizef& centralSize);
 
         /**
-         * @brief - Creates the dock widgets related to each area and hide each one
-         *          of them. They will be revealed if needed when the user adds items
-         *          inside them along the way.
-         *          It also creates the layout to use to position widgets inside the
-         *          area available for this application.
+         * @brief - Creates the layout to use to position widgets inside the area
+         *          available for this application. The dock widgets related to each
+         *          area are only created when the user adds items inside them (see
+         *          `createTabForArea`).
          * @param centralSize - a vector describing for each axis the percentage of
          *                      the total area occupied by the central widget.
          */
@@ -143,6 +545,15 @@ namespace sdl {
         float
         renderCanvas();
 
+        /**
+         * @brief - Computes the duration of a frame from the desired framerate,
+         *          the current degradation level and the presentation mode. When
+         *          frames are synchronized with the display, the duration is a
+         *          whole number of refresh intervals.
+         */
+        void
+        updateFrameDuration() noexcept;
+
         bool
         geometryUpdateEvent(const core::engine::Event& e) override;
 
@@ -162,9 +573,36 @@ namespace sdl {
         bool
         windowResizeEvent(const core::engine::WindowEvent& e) override;
 
+        /**
+         * @brief - Reimplementation of the `EngineObject` methods to keep track of
+         *          the visibility of the window so that the rendering is suspended
+         *          while it is hidden or minimized.
+         * @param e - the event to be interpreted.
+         * @return - `true` if the event was recognized, `false` otherwise.
+         */
+        bool
+        windowShowEvent(const core::engine::WindowEvent& e) override;
+
+        bool
+        windowHideEvent(const core::engine::WindowEvent& e) override;
+
         bool
         quitEvent(const core::engine::QuitEvent& e) override;
 
+        /**
+         * @brief - Reimplementation of the `EngineObject` method so that the widgets
+         *          of this application ignore the events related to the additional
+         *          windows: the events of all windows are dispatched to every
+         *          listener. The events received by the application itself are
+         *          also acknowledged to the system events queue.
+         * @param watched - the widget for which the event is filtered.
+         * @param e - the event to filter.
+         * @return - `true` if the event should not be transmitted to the widget.
+         */
+        bool
+        filterEvent(core::engine::EngineObject* watched,
+                    core::engine::EventShPtr e) override;
+
         /**
          * @brief - Used to draw the input `widget` assuming it is not null.
          *          No checks are performed to determine whether it is actually
@@ -174,6 +612,33 @@ namespace sdl {
         void
         drawWidget(core::SdlWidget* widget);
 
+        /**
+         * @brief - Returns a name describing the top-level area occupied by the
+         *          input widget. The returned string is a literal so that it can
+         *          be safely used by the `m_watchdog`.
+         * @param widget - the widget for which the area should be described.
+         * @return - the name of the area.
+         */
+        const char*
+        getAreaName(const core::SdlWidget* widget) const noexcept;
+
+        /**
+         * @brief - Releases the additional windows which were closed since the
+         *          last frame.
+         *          Assumes that the `m_renderLocker` is already acquired.
+         */
+        void
+        releaseClosedWindows();
+
+        /**
+         * @brief - Whether the main window and all the additional windows are
+         *          hidden or minimized, in which case nothing needs to be
+         *          rendered.
+         * @return - `true` if no window is visible.
+         */
+        bool
+        areAllWindowsHidden();
+
         /**
          * @brief - Internal method allowing to fetch system events using the dedicated
          *          API handler. This method must be called from the main thread which is
@@ -187,14 +652,96 @@ namespace sdl {
         float
         fetchSystemEvents();
 
+        /**
+         * @brief - Used to execute the tasks registered to be run in the main
+         *          thread within the budget defined by `m_tasksBudget`. The
+         *          tasks are executed while holding the `m_renderLocker` so
+         *          that they can safely access the rendering resources.
+         * @return - a floating point value representing the time it took to
+         *           execute the tasks, in milliseconds.
+         */
+        float
+        executeTasks();
+
+        /**
+         * @brief - Used to execute the idle tasks until the `deadline` is reached.
+         *          As for `executeTasks` each unit of work is executed while holding
+         *          the `m_renderLocker` but the lock is released in between so that
+         *          the events thread is not blocked for the whole idle time.
+         * @param deadline - the time at which the idle tasks should stop.
+         */
+        void
+        executeIdleTasks(const IdleTasks::Clock::time_point& deadline);
+
+        /**
+         * @brief - Acquires the `m_renderLocker` and records the time spent waiting
+         *          for it in the trace so that contention between the rendering and
+         *          the events threads can be diagnosed.
+         * @return - a lock holding the `m_renderLocker`.
+         */
+        std::unique_lock<std::recursive_mutex>
+        acquireRenderLocker();
+
+        /**
+         * @brief - Recreates the canvas so that it matches the size of the window
+         *          multiplied by the input `scale`. Widgets are then drawn at this
+         *          scale and the canvas is stretched to the window when presented.
+         *          Assumes that the `m_renderLocker` is already acquired.
+         * @param scale - the scale of the canvas.
+         */
+        void
+        setRenderScale(float scale);
+
       private:
 
-        using WidgetsMap = std::unordered_map<std::string, DockWidgetArea>;
+        /**
+         * @brief - Describes a dock widget registered in the application. Slots
+         *          which are not used are chained through `nextFree` so that they
+         *          can be reused without any allocation.
+         */
+        struct DockSlot {
+          core::SdlWidget* widget;
+          DockWidgetArea area;
+          std::uint32_t generation;
+          std::uint32_t nextFree;
+        };
+
+        /**
+         * @brief - Used to mark the end of the list of free slots.
+         */
+        static constexpr std::uint32_t NoDockSlot = 0xFFFFFFFFu;
+
+        /**
+         * @brief - Removes the dock widget registered in the slot at `index` from
+         *          its tab widget and releases the slot. Assumes that the locker
+         *          is already acquired.
+         * @param index - the index of the slot to release.
+         */
+        void
+        removeDockSlot(std::uint32_t index);
+
+        /**
+         * @brief - Keeps track of the duration of each step of the start-up. It is
+         *          declared first so that its origin matches the creation of this
+         *          application as closely as possible.
+         */
+        StartupTimeline m_startup;
 
         std::string m_title;
 
         float m_framerate;
         float m_frameDuration;
+        std::uint64_t m_frame;
+
+        /**
+         * @brief - The presentation mode and the refresh rate of the display. The
+         *          `m_presentDuration` holds the time spent presenting the last
+         *          frame: with vsync it mostly consists in waiting for the vertical
+         *          blank and should not be considered as work.
+         */
+        PresentationMode m_presentation;
+        float m_refreshRate;
+        float m_presentDuration;
 
         std::mutex m_executionLocker;
         bool m_renderingRunning;
@@ -202,6 +749,22 @@ namespace sdl {
         core::engine::EventsDispatcherShPtr m_eventsDispatcher;
         AppDecoratorShPtr m_engine;
 
+        /**
+         * @brief - The engine decorated by the `m_engine`. It is shared with the
+         *          additional windows of the application.
+         */
+        core::engine::EngineShPtr m_systemEngine;
+
+        EventsRecorder m_recorder;
+        TracerShPtr m_tracer;
+        AsyncLogSinkShPtr m_logSink;
+        AsyncLogSink::Source m_logSource;
+        SystemEventsQueue m_systemEvents;
+
+        TasksQueue m_tasks;
+        float m_tasksBudget;
+        IdleTasks m_idleTasks;
+
         MainWindowLayoutShPtr m_layout;
         core::SdlWidget* m_menuBar;
         graphic::TabWidget* m_toolBar;
@@ -212,12 +775,69 @@ namespace sdl {
         graphic::TabWidget* m_bottomArea;
         core::SdlWidget* m_statusBar;
 
-        WidgetsMap m_widgets;
+        std::vector<DockSlot> m_docks;
+        std::uint32_t m_freeDock;
+
+        /**
+         * @brief - The additional windows opened by this application. They are
+         *          protected by the `m_renderLocker`.
+         */
+        std::vector<AppWindowShPtr> m_windows;
+
+        /**
+         * @brief - Protects the widgets and the canvas of this application. The locker
+         *          is recursive so that batches of modifications (see `beginUpdate`) and
+         *          tasks executed in the main thread can modify the widgets without the
+         *          risk of a deadlock.
+         *          The `m_updateDepth` counts the number of nested batches in progress
+         *          started by the `m_updateOwner` thread and `m_layoutInvalidated`
+         *          indicates that the layout should be updated once the batch
+         *          completes. All are protected by the locker.
+         */
+        std::recursive_mutex m_renderLocker;
+        unsigned m_updateDepth;
+        std::thread::id m_updateOwner;
+        bool m_layoutInvalidated;
 
-        std::mutex m_renderLocker;
         utils::Boxf m_cachedSize;
         utils::Uuid m_window;
-        utils::Uuid m_canvas;
+
+        RenderWatchdog m_watchdog;
+
+        /**
+         * @brief - When all the windows are hidden or minimized the rendering is
+         *          suspended and the system events are only fetched every
+         *          `m_hiddenFrameDuration` milliseconds. It is atomic as it can
+         *          be modified from any thread.
+         */
+        std::atomic<float> m_hiddenFrameDuration;
+
+        /**
+         * @brief - The scale at which the canvas is rendered compared to the
+         *          size of the window and the controller updating it when the
+         *          dynamic resolution is active.
+         */
+        float m_renderScale;
+        ResolutionScaler m_scaler;
+
+        /**
+         * @brief - The part of the last frame which depends on the scale of the
+         *          canvas: composing the canvas and presenting it. The time spent
+         *          waiting for the vertical blank is not included.
+         */
+        float m_scaledDuration;
+
+        /**
+         * @brief - Degrades the rendering when frames exceed their budget. The
+         *          `m_fullRepaint` boolean indicates that the whole canvas needs
+         *          to be repainted on the next frame, while `m_areasGeneration`
+         *          allows to detect that the layout produced a new solution: in
+         *          both cases the peripheral areas need to be repainted.
+         */
+        FrameGovernor m_governor;
+        bool m_fullRepaint;
+        std::uint64_t m_areasGeneration;
+
         core::engine::Palette m_palette;
     };
 
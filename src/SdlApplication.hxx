@@ -6,6 +6,25 @@
 namespace sdl {
   namespace app {
 
+    inline
+    SdlApplication::UpdateBatch::UpdateBatch(SdlApplication& app):
+      m_app(app)
+    {
+      m_app.beginUpdate();
+    }
+
+    inline
+    SdlApplication::UpdateBatch::~UpdateBatch() {
+      // Failures to recompute the layout are already reported by the layout
+      // itself: we only need to make sure that the batch is ended.
+      try {
+        m_app.endUpdate();
+      }
+      catch (const std::exception& e) {
+        m_app.warn(std::string("Failed to end batch of modifications (err: ") + e.what() + ")");
+      }
+    }
+
     inline
     SdlApplication::~SdlApplication() {
       stop();
@@ -49,6 +68,119 @@ namespace sdl {
       m_engine->setWindowIcon(m_window, icon);
     }
 
+    inline
+    void
+    SdlApplication::quit() {
+      stopRendering();
+    }
+
+    inline
+    void
+    SdlApplication::recordEvents(const std::string& file) {
+      m_recorder.startRecording(file);
+    }
+
+    inline
+    void
+    SdlApplication::replayEvents(const std::string& file,
+                                 const EventsRecorder::ReplayTiming& timing)
+    {
+      m_recorder.startReplay(file, timing);
+    }
+
+    inline
+    void
+    SdlApplication::stopEventsTrace() {
+      m_recorder.stop();
+    }
+
+    inline
+    void
+    SdlApplication::startTracing() {
+      m_tracer->clear();
+      m_tracer->setEnabled(true);
+    }
+
+    inline
+    void
+    SdlApplication::stopTracing() {
+      m_tracer->setEnabled(false);
+    }
+
+    inline
+    void
+    SdlApplication::dumpTrace(const std::string& file) {
+      m_tracer->dump(file);
+    }
+
+    inline
+    void
+    SdlApplication::startAsyncLogging() {
+      m_logSink->start();
+    }
+
+    inline
+    void
+    SdlApplication::stopAsyncLogging() {
+      m_logSink->stop();
+    }
+
+    inline
+    std::uint64_t
+    SdlApplication::getDroppedLogCount() const noexcept {
+      return m_logSink->getDroppedCount();
+    }
+
+    inline
+    void
+    SdlApplication::setEventsQueueLimits(std::size_t capacity,
+                                         std::size_t batch)
+    {
+      m_systemEvents.setLimits(capacity, batch);
+    }
+
+    inline
+    SystemEventsQueue::Metrics
+    SdlApplication::getEventsQueueMetrics() {
+      return m_systemEvents.getMetrics();
+    }
+
+    inline
+    std::vector<StartupTimeline::Phase>
+    SdlApplication::getStartupTimeline() {
+      return m_startup.getPhases();
+    }
+
+    inline
+    std::string
+    SdlApplication::getStartupReport() {
+      return m_startup.toJson();
+    }
+
+    inline
+    void
+    SdlApplication::postTask(TasksQueue::Task task) {
+      m_tasks.post(task);
+    }
+
+    inline
+    void
+    SdlApplication::setTasksBudget(float budget) noexcept {
+      m_tasksBudget = std::max(0.0f, budget);
+    }
+
+    inline
+    unsigned
+    SdlApplication::addIdleTask(IdleTasks::Task task) {
+      return m_idleTasks.add(task);
+    }
+
+    inline
+    void
+    SdlApplication::removeIdleTask(unsigned id) {
+      m_idleTasks.remove(id);
+    }
+
     inline
     void
     SdlApplication::startRendering() noexcept {
@@ -83,6 +215,28 @@ namespace sdl {
       // Set up the widget with internal elements.
       registerToSameQueue(widget);
       widget->setEngine(m_engine);
+
+      // Prevent the widget from reacting to the events of other windows.
+      widget->installEventFilter(this);
+    }
+
+    inline
+    bool
+    SdlApplication::filterEvent(core::engine::EngineObject* watched,
+                                core::engine::EventShPtr e)
+    {
+      // Acknowledge the events delivered to the application so that the system
+      // events queue can forward new ones.
+      if (watched == this && e != nullptr) {
+        m_systemEvents.acknowledge(*e);
+      }
+
+      // Events which are not related to a window are always transmitted.
+      if (e != nullptr && e->getWindID().valid() && !(e->getWindID() == m_window)) {
+        return true;
+      }
+
+      return core::engine::EngineObject::filterEvent(watched, e);
     }
 
     inline
@@ -116,11 +270,16 @@ namespace sdl {
     void
     SdlApplication::setLayout(MainWindowLayoutShPtr layout) {
       // Lock this application.
-      const std::lock_guard guard(m_renderLocker);
+      const std::unique_lock guard = acquireRenderLocker();
 
       // Assign the new layout.
       m_layout = layout;
 
+      if (m_layout != nullptr) {
+        m_layout->setTracer(m_tracer);
+        m_layout->setLogSink(m_logSink);
+      }
+
       // Assign its events queue so that it is consistent with
       // the internal queue of the application.
       registerToSameQueue(m_layout.get());
@@ -129,6 +288,77 @@ namespace sdl {
       invalidate();
     }
 
+    inline
+    void
+    SdlApplication::beginUpdate() {
+      std::unique_lock guard = acquireRenderLocker();
+
+      if (m_updateDepth == 0u) {
+        if (m_layout != nullptr) {
+          m_layout->beginUpdate();
+        }
+
+        m_updateOwner = std::this_thread::get_id();
+      }
+
+      ++m_updateDepth;
+
+      // Keep the application locked until the end of the batch: the lock is
+      // released by the matching `endUpdate`.
+      guard.release();
+    }
+
+    inline
+    void
+    SdlApplication::endUpdate() {
+      // The locker is recursive: acquiring it once more allows to safely check
+      // that the calling thread owns the batch, and so the lock.
+      const std::unique_lock guard = acquireRenderLocker();
+
+      if (m_updateDepth == 0u || m_updateOwner != std::this_thread::get_id()) {
+        error(
+          std::string("Could not end update of application"),
+          std::string("No update in progress for this thread")
+        );
+      }
+
+      // The lock was acquired by `beginUpdate`: make sure it is released even
+      // if the recomputation of the layout fails.
+      const std::unique_lock batch(m_renderLocker, std::adopt_lock);
+
+      --m_updateDepth;
+
+      // Perform the recomputation of the layout if needed.
+      if (m_updateDepth == 0u && m_layout != nullptr) {
+        if (m_layoutInvalidated) {
+          m_layout->invalidate();
+        }
+
+        m_layout->endUpdate();
+      }
+
+      if (m_updateDepth == 0u) {
+        m_layoutInvalidated = false;
+        m_updateOwner = std::thread::id();
+      }
+    }
+
+    inline
+    void
+    SdlApplication::invalidateLayout() {
+      if (m_layout == nullptr) {
+        return;
+      }
+
+      // Delay the recomputation in case a batch is in progress.
+      if (m_updateDepth > 0u) {
+        m_layoutInvalidated = true;
+        return;
+      }
+
+      m_layout->invalidate();
+    }
+
     inline
     void
     SdlApplication::invalidate() {
@@ -169,6 +399,12 @@ namespace sdl {
     inline
     bool
     SdlApplication::quitEvent(const core::engine::QuitEvent& e) {
+      // Closing an additional window only closes this window: it is handled
+      // by the window itself.
+      if (e.getWindID().valid() && !(e.getWindID() == m_window)) {
+        return core::engine::EngineObject::quitEvent(e);
+      }
+
       // Stop rendering.
       stopRendering();
 
@@ -183,21 +419,175 @@ namespace sdl {
       // of the actual API used to fetch system events. Note that as we assume
       // that the locker for this application is already locked we can safely
       // go ahead and use the `m_engine` pointer.
+      const Tracer::Scope scope(m_tracer.get(), "main", "fetch_system_events");
+      m_watchdog.beat("fetch_system_events");
       auto start = std::chrono::steady_clock::now();
 
-      std::vector<core::engine::EventShPtr> events = m_engine->pollEvents();
+      // Notify the recorder that a new frame starts: this will either inject
+      // the events of the trace being replayed or associate the events to be
+      // fetched to this frame. During a replay the live input is filtered out
+      // of the system queue so the injected events are the only input going
+      // through the pipeline below.
+      m_recorder.beginFrame(m_frame);
+
+      m_systemEvents.push(m_engine->pollEvents());
 
-      // Populate the events dispatcher with the events.
-      m_eventsDispatcher->pumpEvents(events);
+      // Populate the events dispatcher with the events. We only forward what
+      // the dispatcher can absorb given the events it did not process yet: in
+      // case the events thread lags behind the extra events stay in the bounded
+      // queue where stale motion can be dropped instead of piling up there.
+      m_eventsDispatcher->pumpEvents(m_systemEvents.pop());
 
       auto end = std::chrono::steady_clock::now();
 
       auto nanoDuration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
-      verbose("Events pumping took " + std::to_string(nanoDuration/1000) + "µs");
+      m_logSink->log(m_logSource, AsyncLogSink::Level::Verbose, "Events pumping took {}µs", nanoDuration / 1000);
 
       return std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
     }
 
+    inline
+    float
+    SdlApplication::executeTasks() {
+      // Avoid locking the application if there's nothing to do.
+      if (m_tasks.size() == 0u) {
+        return 0.0f;
+      }
+
+      const Tracer::Scope scope(m_tracer.get(), "main", "execute_tasks");
+      m_watchdog.beat("execute_tasks");
+      const std::unique_lock guard = acquireRenderLocker();
+
+      return m_tasks.drain(m_tasksBudget);
+    }
+
+    inline
+    void
+    SdlApplication::executeIdleTasks(const IdleTasks::Clock::time_point& deadline) {
+      // Avoid locking the application if there's nothing to do.
+      if (m_idleTasks.empty()) {
+        return;
+      }
+
+      const Tracer::Scope scope(m_tracer.get(), "main", "idle_tasks");
+      m_watchdog.beat("idle_tasks");
+
+      m_idleTasks.run(
+        deadline,
+        [this]() {
+          return acquireRenderLocker();
+        }
+      );
+    }
+
+    inline
+    void
+    SdlApplication::setDynamicResolution(bool enabled,
+                                         float minScale,
+                                         float maxScale)
+    {
+      const std::unique_lock guard = acquireRenderLocker();
+
+      m_scaler.setBounds(minScale, maxScale);
+      m_scaler.setEnabled(enabled);
+
+      setRenderScale(enabled ? m_scaler.getScale() : 1.0f);
+    }
+
+    inline
+    float
+    SdlApplication::getRenderScale() {
+      const std::unique_lock guard = acquireRenderLocker();
+      return m_renderScale;
+    }
+
+    inline
+    void
+    SdlApplication::setFrameDegradation(bool enabled) {
+      const std::unique_lock guard = acquireRenderLocker();
+
+      // The framerate is updated by the rendering loop on the next frame.
+      m_governor.setEnabled(enabled);
+    }
+
+    inline
+    void
+    SdlApplication::setDegradationSteps(const std::vector<FrameGovernor::Step>& steps) {
+      const std::unique_lock guard = acquireRenderLocker();
+      m_governor.setSteps(steps);
+    }
+
+    inline
+    void
+    SdlApplication::setOverrunSummaryInterval(float interval) {
+      const std::unique_lock guard = acquireRenderLocker();
+      m_governor.setSummaryInterval(interval);
+    }
+
+    inline
+    unsigned
+    SdlApplication::getDegradationLevel() {
+      const std::unique_lock guard = acquireRenderLocker();
+      return m_governor.getLevel();
+    }
+
+    inline
+    void
+    SdlApplication::setWatchdog(float threshold,
+                                bool skipStalled,
+                                unsigned retryInterval)
+    {
+      m_watchdog.setThreshold(threshold);
+      m_watchdog.setSkipStalled(skipStalled, retryInterval);
+
+      // Apply the new configuration right away if the rendering loop runs.
+      if (isRendering()) {
+        if (threshold > 0.0f) {
+          m_watchdog.start();
+        }
+        else {
+          m_watchdog.stop();
+        }
+      }
+    }
+
+    inline
+    std::uint64_t
+    SdlApplication::getStallCount() const noexcept {
+      return m_watchdog.getStallCount();
+    }
+
+    inline
+    void
+    SdlApplication::setHiddenEventsRate(float rate) {
+      m_hiddenFrameDuration.store(1000.0f / std::max(0.1f, rate));
+    }
+
+    inline
+    bool
+    SdlApplication::isWindowHidden() const noexcept {
+      return m_engine != nullptr && m_engine->isWindowHidden();
+    }
+
+    inline
+    PresentationMode
+    SdlApplication::getPresentationMode() const noexcept {
+      return m_presentation;
+    }
+
+    inline
+    float
+    SdlApplication::getRefreshRate() const noexcept {
+      return m_refreshRate;
+    }
+
+    inline
+    std::unique_lock<std::recursive_mutex>
+    SdlApplication::acquireRenderLocker() {
+      const Tracer::Scope scope(m_tracer.get(), "lock", "wait_render_locker");
+      return std::unique_lock<std::recursive_mutex>(m_renderLocker);
+    }
+
   }
 }
 
@@ -0,0 +1,105 @@
+
+# include "StartupTimeline.hh"
+
+namespace sdl {
+  namespace app {
+
+    StartupTimeline::StartupTimeline():
+      utils::CoreObject(std::string("startup_timeline")),
+
+      m_locker(),
+      m_origin(Clock::now()),
+
+      m_phases(),
+      m_phaseStart(m_origin),
+      m_running(false),
+      m_complete(false)
+    {
+      setService("startup");
+    }
+
+    void
+    StartupTimeline::begin(const std::string& name) {
+      const std::lock_guard guard(m_locker);
+
+      if (m_complete) {
+        return;
+      }
+
+      endPrivate();
+
+      m_phaseStart = Clock::now();
+      m_phases.push_back(Phase{name, std::chrono::duration_cast<std::chrono::microseconds>(m_phaseStart - m_origin).count() / 1000.0f, 0.0f});
+      m_running = true;
+    }
+
+    void
+    StartupTimeline::complete() {
+      const std::lock_guard guard(m_locker);
+
+      if (m_complete) {
+        return;
+      }
+
+      endPrivate();
+      m_complete = true;
+
+      // Log a summary so that slow start-ups can be investigated even if
+      // the report is not explicitly requested.
+      const int id = slowest();
+      if (id < 0) {
+        return;
+      }
+
+      notice(
+        "Start-up took " + std::to_string(elapsed(m_origin)) + "ms, slowest phase is \"" +
+        m_phases[id].name + "\" with " + std::to_string(m_phases[id].duration) + "ms"
+      );
+    }
+
+    std::string
+    StartupTimeline::toJson() {
+      const std::lock_guard guard(m_locker);
+
+      const int id = slowest();
+
+      float total = 0.0f;
+      if (!m_phases.empty()) {
+        total = m_phases.back().start + m_phases.back().duration;
+      }
+
+      std::string out = "{\"total_ms\": " + std::to_string(total) + ", ";
+      out += "\"complete\": " + std::string(m_complete ? "true" : "false") + ", ";
+      out += "\"slowest\": \"" + (id < 0 ? std::string() : m_phases[id].name) + "\", ";
+      out += "\"phases\": [";
+
+      for (unsigned phase = 0u ; phase < m_phases.size() ; ++phase) {
+        if (phase > 0u) {
+          out += ", ";
+        }
+
+        out += "{\"name\": \"" + m_phases[phase].name + "\", ";
+        out += "\"start_ms\": " + std::to_string(m_phases[phase].start) + ", ";
+        out += "\"duration_ms\": " + std::to_string(m_phases[phase].duration) + "}";
+      }
+
+      out += "]}";
+
+      return out;
+    }
+
+    int
+    StartupTimeline::slowest() const noexcept {
+      int best = -1;
+
+      for (unsigned id = 0u ; id < m_phases.size() ; ++id) {
+        if (best < 0 || m_phases[id].duration > m_phases[best].duration) {
+          best = static_cast<int>(id);
+        }
+      }
+
+      return best;
+    }
+
+  }
+}
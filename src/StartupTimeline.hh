@@ -0,0 +1,116 @@
+#ifndef    STARTUP_TIMELINE_HH
+# define   STARTUP_TIMELINE_HH
+
+# include <mutex>
+# include <chrono>
+# include <memory>
+# include <string>
+# include <vector>
+# include <core_utils/CoreObject.hh>
+
+namespace sdl {
+  namespace app {
+
+    class StartupTimeline: public utils::CoreObject {
+      public:
+
+        using Clock = std::chrono::steady_clock;
+
+        /**
+         * @brief - Describes a single phase of the start-up. Both the `start`
+         *          and the `duration` are expressed in milliseconds, the start
+         *          being relative to the creation of the timeline.
+         */
+        struct Phase {
+          std::string name;
+          float start;
+          float duration;
+        };
+
+        StartupTimeline();
+
+        virtual ~StartupTimeline();
+
+        /**
+         * @brief - Starts a new phase with the specified name. Any phase which
+         *          was still running is ended first. Phases recorded after the
+         *          timeline is complete are ignored.
+         * @param name - the name of the phase.
+         */
+        void
+        begin(const std::string& name);
+
+        /**
+         * @brief - Ends the current phase if any.
+         */
+        void
+        end();
+
+        /**
+         * @brief - Marks the timeline as complete: the current phase is ended and
+         *          a summary highlighting the slowest phase is logged.
+         */
+        void
+        complete();
+
+        bool
+        isComplete() noexcept;
+
+        /**
+         * @brief - Returns the phases recorded so far in chronological order.
+         * @return - the list of phases.
+         */
+        std::vector<Phase>
+        getPhases();
+
+        /**
+         * @brief - Serializes the timeline into a JSON object listing the phases
+         *          along with the total duration and the name of the slowest one.
+         * @return - a string representing the timeline in JSON format.
+         */
+        std::string
+        toJson();
+
+      private:
+
+        /**
+         * @brief - Ends the current phase assuming the locker is acquired.
+         */
+        void
+        endPrivate();
+
+        /**
+         * @brief - Returns the index of the slowest phase recorded so far or a
+         *          negative value if no phase exists. Assumes that the locker is
+         *          already acquired.
+         * @return - the index of the slowest phase.
+         */
+        int
+        slowest() const noexcept;
+
+        float
+        elapsed(const Clock::time_point& from) const noexcept;
+
+      private:
+
+        std::mutex m_locker;
+        Clock::time_point m_origin;
+
+        /**
+         * @brief - The phases recorded so far. The `m_running` boolean indicates
+         *          that the last phase is still in progress and the `m_complete`
+         *          one prevents any further phase to be recorded.
+         */
+        std::vector<Phase> m_phases;
+        Clock::time_point m_phaseStart;
+        bool m_running;
+        bool m_complete;
+    };
+
+    using StartupTimelineShPtr = std::shared_ptr<StartupTimeline>;
+  }
+}
+
+# include "StartupTimeline.hxx"
+
+#endif    /* STARTUP_TIMELINE_HH */
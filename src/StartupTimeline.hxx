@@ -0,0 +1,53 @@
+#ifndef    STARTUP_TIMELINE_HXX
+# define   STARTUP_TIMELINE_HXX
+
+# include "StartupTimeline.hh"
+
+namespace sdl {
+  namespace app {
+
+    inline
+    StartupTimeline::~StartupTimeline() {}
+
+    inline
+    void
+    StartupTimeline::end() {
+      const std::lock_guard guard(m_locker);
+      endPrivate();
+    }
+
+    inline
+    bool
+    StartupTimeline::isComplete() noexcept {
+      const std::lock_guard guard(m_locker);
+      return m_complete;
+    }
+
+    inline
+    std::vector<StartupTimeline::Phase>
+    StartupTimeline::getPhases() {
+      const std::lock_guard guard(m_locker);
+      return m_phases;
+    }
+
+    inline
+    void
+    StartupTimeline::endPrivate() {
+      if (!m_running) {
+        return;
+      }
+
+      m_phases.back().duration = elapsed(m_phaseStart);
+      m_running = false;
+    }
+
+    inline
+    float
+    StartupTimeline::elapsed(const Clock::time_point& from) const noexcept {
+      return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - from).count() / 1000.0f;
+    }
+
+  }
+}
+
+#endif    /* STARTUP_TIMELINE_HXX */
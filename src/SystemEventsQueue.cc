@@ -0,0 +1,123 @@
+
+# include "SystemEventsQueue.hh"
+
+namespace sdl {
+  namespace app {
+
+    SystemEventsQueue::SystemEventsQueue(std::size_t capacity,
+                                         std::size_t batch):
+      utils::CoreObject(std::string("system_events_queue")),
+
+      m_locker(),
+
+      m_capacity(std::max(static_cast<std::size_t>(1u), capacity)),
+      m_batch(batch),
+      m_policies(),
+
+      m_events(),
+      m_inFlight(),
+
+      m_metrics(Metrics{0u, 0u, 0u, 0u, 0u, 0u, {}})
+    {
+      setService("events");
+
+      // Motion events are only relevant until a newer one is received: they
+      // are the first to go when the queue is full. Any other event (clicks,
+      // keys, quit, etc.) is never dropped.
+      m_policies[core::engine::Event::Type::MouseMove] = DropPolicy::DropOldest;
+    }
+
+    void
+    SystemEventsQueue::push(const std::vector<core::engine::EventShPtr>& events) {
+      const std::lock_guard guard(m_locker);
+
+      // Events forwarded to the dispatcher cannot be dropped anymore but they
+      // still count against the capacity.
+      const std::size_t pending = m_inFlight.size();
+
+      for (unsigned id = 0u ; id < events.size() ; ++id) {
+        const core::engine::EventShPtr& e = events[id];
+        if (e == nullptr) {
+          continue;
+        }
+
+        ++m_metrics.received;
+
+        // Make room for this event if needed. In case no event can be dropped
+        // we still keep the event: it means that the queue only contains some
+        // events which should not be lost.
+        if (m_events.size() + pending >= m_capacity && !dropOldest()) {
+          ++m_metrics.overflows;
+        }
+
+        m_events.push_back(e);
+      }
+
+      m_metrics.highWaterMark = std::max(m_metrics.highWaterMark, m_events.size() + pending);
+    }
+
+    std::vector<core::engine::EventShPtr>
+    SystemEventsQueue::pop() {
+      const std::lock_guard guard(m_locker);
+
+      // Only forward what the dispatcher can absorb within the capacity: the
+      // remaining events stay here where stale ones can still be dropped.
+      const std::size_t pending = m_inFlight.size();
+      std::size_t count = (pending < m_capacity ? m_capacity - pending : 0u);
+
+      if (m_batch > 0u) {
+        count = std::min(count, m_batch);
+      }
+      count = std::min(std::max(count, static_cast<std::size_t>(1u)), m_events.size());
+
+      std::vector<core::engine::EventShPtr> out(
+        m_events.begin(),
+        m_events.begin() + count
+      );
+      m_events.erase(m_events.begin(), m_events.begin() + count);
+
+      for (unsigned id = 0u ; id < out.size() ; ++id) {
+        m_inFlight.push_back(out[id].get());
+      }
+      while (m_inFlight.size() > m_capacity) {
+        m_inFlight.pop_front();
+      }
+
+      m_metrics.forwarded += count;
+
+      return out;
+    }
+
+    void
+    SystemEventsQueue::acknowledge(const core::engine::Event& e) {
+      const std::lock_guard guard(m_locker);
+
+      // Events are usually delivered in the order they were forwarded so the
+      // acknowledged one is most likely at the front.
+      std::deque<const core::engine::Event*>::iterator it = std::find(m_inFlight.begin(), m_inFlight.end(), &e);
+      if (it != m_inFlight.end()) {
+        m_inFlight.erase(it);
+      }
+    }
+
+    bool
+    SystemEventsQueue::dropOldest() {
+      // Traverse the queue from the oldest event and remove the first one
+      // which can be dropped.
+      std::deque<core::engine::EventShPtr>::iterator e = m_events.begin();
+      while (e != m_events.end() && getDropPolicy((*e)->getType()) != DropPolicy::DropOldest) {
+        ++e;
+      }
+
+      if (e == m_events.end()) {
+        return false;
+      }
+
+      ++m_metrics.dropped[(*e)->getType()];
+      m_events.erase(e);
+
+      return true;
+    }
+
+  }
+}
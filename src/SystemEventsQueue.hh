@@ -0,0 +1,153 @@
+#ifndef    SYSTEM_EVENTS_QUEUE_HH
+# define   SYSTEM_EVENTS_QUEUE_HH
+
+# include <mutex>
+# include <deque>
+# include <algorithm>
+# include <memory>
+# include <vector>
+# include <cstdint>
+# include <unordered_map>
+# include <core_utils/CoreObject.hh>
+# include <sdl_engine/Event.hh>
+
+namespace sdl {
+  namespace app {
+
+    class SystemEventsQueue: public utils::CoreObject {
+      public:
+
+        /**
+         * @brief - Describes what can happen to an event of a given type when
+         *          the queue is full.
+         *          `Never` means that the event is always kept, even if it makes
+         *          the queue exceed its capacity, while `DropOldest` indicates
+         *          that the oldest event of this type can be discarded to make
+         *          room for new events.
+         */
+        enum class DropPolicy {
+          Never,
+          DropOldest
+        };
+
+        /**
+         * @brief - Convenience structure describing the activity of the queue.
+         *          The `depth` is the number of events currently waiting to be
+         *          forwarded while `inFlight` counts the events forwarded to the
+         *          dispatcher which were not acknowledged yet. The `highWaterMark`
+         *          is the largest total of both ever reached.
+         *          The `dropped` table keeps track of the number of events which
+         *          were discarded for each type, and `overflows` counts the times
+         *          an event was kept even though the queue was full because no
+         *          event could be dropped.
+         */
+        struct Metrics {
+          std::size_t depth;
+          std::size_t inFlight;
+          std::size_t highWaterMark;
+          std::uint64_t received;
+          std::uint64_t forwarded;
+          std::uint64_t overflows;
+          std::unordered_map<core::engine::Event::Type, std::uint64_t> dropped;
+        };
+
+        /**
+         * @brief - Creates a new queue with the specified capacity.
+         * @param capacity - the maximum number of events waiting to be processed,
+         *                   either in this queue or in the dispatcher, before
+         *                   events start being dropped.
+         * @param batch - the maximum number of events forwarded at once. A value
+         *                of `0` means that only the capacity limits forwarding.
+         */
+        SystemEventsQueue(std::size_t capacity = 256u,
+                          std::size_t batch = 0u);
+
+        virtual ~SystemEventsQueue();
+
+        void
+        setLimits(std::size_t capacity,
+                  std::size_t batch);
+
+        void
+        setDropPolicy(const core::engine::Event::Type& type,
+                      const DropPolicy& policy);
+
+        /**
+         * @brief - Appends the input events at the end of the queue. In case the
+         *          capacity is exceeded by the events of this queue and the ones
+         *          still pending in the dispatcher, the oldest events which can
+         *          be dropped are discarded.
+         * @param events - the events to enqueue.
+         */
+        void
+        push(const std::vector<core::engine::EventShPtr>& events);
+
+        /**
+         * @brief - Retrieves from the front of the queue as many events as the
+         *          dispatcher can accept: the number of events it did not process
+         *          yet is the number of forwarded events not acknowledged yet. At
+         *          least one event is returned if the queue is not empty so that
+         *          events are never stuck.
+         * @return - the events to forward to the dispatcher, in the order they were
+         *           received.
+         */
+        std::vector<core::engine::EventShPtr>
+        pop();
+
+        /**
+         * @brief - Notifies the queue that the dispatcher delivered the input event.
+         *          In case it was forwarded by this queue it does not count as
+         *          pending in the dispatcher anymore. Acknowledging an event more
+         *          than once or an event which was not forwarded has no effect.
+         *          This method is meant to be called from the events thread.
+         * @param e - the event delivered by the dispatcher.
+         */
+        void
+        acknowledge(const core::engine::Event& e);
+
+        Metrics
+        getMetrics();
+
+      private:
+
+        DropPolicy
+        getDropPolicy(const core::engine::Event::Type& type) const noexcept;
+
+        /**
+         * @brief - Attempts to discard the oldest event which can be dropped from
+         *          the queue. Assumes that the locker is already acquired.
+         * @return - `true` if an event could be dropped, `false` otherwise.
+         */
+        bool
+        dropOldest();
+
+      private:
+
+        using Policies = std::unordered_map<core::engine::Event::Type, DropPolicy>;
+
+        std::mutex m_locker;
+
+        std::size_t m_capacity;
+        std::size_t m_batch;
+        Policies m_policies;
+
+        std::deque<core::engine::EventShPtr> m_events;
+
+        /**
+         * @brief - The events forwarded to the dispatcher and not acknowledged yet,
+         *          from the oldest to the most recent. They are only used as keys
+         *          and never dereferenced. At most `m_capacity` entries are kept
+         *          so that events never delivered do not block the forwarding.
+         */
+        std::deque<const core::engine::Event*> m_inFlight;
+
+        Metrics m_metrics;
+    };
+
+    using SystemEventsQueueShPtr = std::shared_ptr<SystemEventsQueue>;
+  }
+}
+
+# include "SystemEventsQueue.hxx"
+
+#endif    /* SYSTEM_EVENTS_QUEUE_HH */
@@ -0,0 +1,58 @@
+#ifndef    SYSTEM_EVENTS_QUEUE_HXX
+# define   SYSTEM_EVENTS_QUEUE_HXX
+
+# include "SystemEventsQueue.hh"
+
+namespace sdl {
+  namespace app {
+
+    inline
+    SystemEventsQueue::~SystemEventsQueue() {}
+
+    inline
+    void
+    SystemEventsQueue::setLimits(std::size_t capacity,
+                                 std::size_t batch)
+    {
+      const std::lock_guard guard(m_locker);
+
+      m_capacity = std::max(static_cast<std::size_t>(1u), capacity);
+      m_batch = batch;
+    }
+
+    inline
+    void
+    SystemEventsQueue::setDropPolicy(const core::engine::Event::Type& type,
+                                     const DropPolicy& policy)
+    {
+      const std::lock_guard guard(m_locker);
+      m_policies[type] = policy;
+    }
+
+    inline
+    SystemEventsQueue::Metrics
+    SystemEventsQueue::getMetrics() {
+      const std::lock_guard guard(m_locker);
+
+      m_metrics.depth = m_events.size();
+      m_metrics.inFlight = m_inFlight.size();
+
+      return m_metrics;
+    }
+
+    inline
+    SystemEventsQueue::DropPolicy
+    SystemEventsQueue::getDropPolicy(const core::engine::Event::Type& type) const noexcept {
+      // Events are never dropped unless specified otherwise.
+      Policies::const_iterator policy = m_policies.find(type);
+      if (policy == m_policies.cend()) {
+        return DropPolicy::Never;
+      }
+
+      return policy->second;
+    }
+
+  }
+}
+
+#endif    /* SYSTEM_EVENTS_QUEUE_HXX */
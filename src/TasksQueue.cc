@@ -0,0 +1,58 @@
+
+# include "TasksQueue.hh"
+# include <chrono>
+
+namespace sdl {
+  namespace app {
+
+    TasksQueue::TasksQueue():
+      utils::CoreObject(std::string("tasks_queue")),
+
+      m_locker(),
+      m_tasks()
+    {
+      setService("tasks");
+    }
+
+    float
+    TasksQueue::drain(float budget) {
+      auto start = std::chrono::steady_clock::now();
+
+      // Only consider the tasks registered so far: this prevents tasks which
+      // post new tasks from monopolizing the execution.
+      std::size_t pending = size();
+
+      float elapsed = 0.0f;
+      unsigned executed = 0u;
+
+      while (pending > 0u && (executed == 0u || elapsed < budget)) {
+        Task task;
+        {
+          const std::lock_guard guard(m_locker);
+          task = m_tasks.front();
+          m_tasks.pop_front();
+        }
+
+        // Execute the task without holding the locker so that it can post
+        // new tasks if needed.
+        withSafetyNet(task, std::string("task_") + std::to_string(executed));
+
+        --pending;
+        ++executed;
+
+        auto now = std::chrono::steady_clock::now();
+        elapsed = std::chrono::duration_cast<std::chrono::microseconds>(now - start).count() / 1000.0f;
+      }
+
+      if (pending > 0u) {
+        verbose(
+          "Executed " + std::to_string(executed) + " task(s) in " + std::to_string(elapsed) + "ms, " +
+          std::to_string(pending) + " carried over to next frame"
+        );
+      }
+
+      return elapsed;
+    }
+
+  }
+}
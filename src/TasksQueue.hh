@@ -0,0 +1,59 @@
+#ifndef    TASKS_QUEUE_HH
+# define   TASKS_QUEUE_HH
+
+# include <mutex>
+# include <deque>
+# include <memory>
+# include <functional>
+# include <core_utils/CoreObject.hh>
+
+namespace sdl {
+  namespace app {
+
+    class TasksQueue: public utils::CoreObject {
+      public:
+
+        using Task = std::function<void()>;
+
+        TasksQueue();
+
+        virtual ~TasksQueue();
+
+        /**
+         * @brief - Registers a new task to be executed the next time the queue
+         *          is drained. This method can be called from any thread.
+         * @param task - the task to execute.
+         */
+        void
+        post(Task task);
+
+        std::size_t
+        size() noexcept;
+
+        /**
+         * @brief - Executes the pending tasks in the order they were posted until
+         *          either the queue is empty or the `budget` is exhausted. Tasks
+         *          which could not be executed are kept for the next call.
+         *          Note that at least one task is executed (if any) so that the
+         *          queue always makes progress, and that tasks posted while the
+         *          queue is drained are only handled on the next call.
+         * @param budget - the time allocated to the execution of the tasks, in
+         *                 milliseconds.
+         * @return - the time it took to execute the tasks, in milliseconds.
+         */
+        float
+        drain(float budget);
+
+      private:
+
+        std::mutex m_locker;
+        std::deque<Task> m_tasks;
+    };
+
+    using TasksQueueShPtr = std::shared_ptr<TasksQueue>;
+  }
+}
+
+# include "TasksQueue.hxx"
+
+#endif    /* TASKS_QUEUE_HH */
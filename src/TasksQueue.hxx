@@ -0,0 +1,34 @@
+#ifndef    TASKS_QUEUE_HXX
+# define   TASKS_QUEUE_HXX
+
+# include "TasksQueue.hh"
+
+namespace sdl {
+  namespace app {
+
+    inline
+    TasksQueue::~TasksQueue() {}
+
+    inline
+    void
+    TasksQueue::post(Task task) {
+      // Check degenerate cases.
+      if (!task) {
+        error(std::string("Cannot post invalid task"));
+      }
+
+      const std::lock_guard guard(m_locker);
+      m_tasks.push_back(task);
+    }
+
+    inline
+    std::size_t
+    TasksQueue::size() noexcept {
+      const std::lock_guard guard(m_locker);
+      return m_tasks.size();
+    }
+
+  }
+}
+
+#endif    /* TASKS_QUEUE_HXX */
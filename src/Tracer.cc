@@ -0,0 +1,180 @@
+
+# include "Tracer.hh"
+# include <fstream>
+
+namespace sdl {
+  namespace app {
+
+    Tracer::Tracer(std::size_t capacity):
+      utils::CoreObject(std::string("tracer")),
+
+      m_id(generateID()),
+
+      m_enabled(false),
+      m_capacity(capacity),
+      m_origin(Clock::now()),
+
+      m_locker(),
+      m_buffers()
+    {
+      setService("trace");
+    }
+
+    void
+    Tracer::record(const char* category,
+                   const std::string& name,
+                   const Clock::time_point& start,
+                   const Clock::time_point& end)
+    {
+      Buffer& buffer = getBuffer();
+
+      const std::lock_guard guard(buffer.locker);
+
+      if (buffer.spans.size() >= m_capacity) {
+        ++buffer.dropped;
+        return;
+      }
+
+      buffer.spans.push_back(
+        Span{
+          category,
+          name,
+          std::chrono::duration_cast<std::chrono::microseconds>(start - m_origin).count(),
+          std::chrono::duration_cast<std::chrono::microseconds>(end - start).count()
+        }
+      );
+    }
+
+    void
+    Tracer::clear() {
+      const std::lock_guard guard(m_locker);
+
+      for (std::unordered_map<std::thread::id, BufferShPtr>::iterator it = m_buffers.begin() ; it != m_buffers.end() ; ++it) {
+        const std::lock_guard bufferGuard(it->second->locker);
+
+        it->second->spans.clear();
+        it->second->dropped = 0u;
+      }
+    }
+
+    std::string
+    Tracer::toJson() {
+      const std::lock_guard guard(m_locker);
+
+      std::string out("{\"displayTimeUnit\": \"ms\", \"traceEvents\": [");
+      bool first = true;
+
+      for (std::unordered_map<std::thread::id, BufferShPtr>::const_iterator it = m_buffers.cbegin() ; it != m_buffers.cend() ; ++it) {
+        Buffer& buffer = *it->second;
+        const std::lock_guard bufferGuard(buffer.locker);
+
+        const std::string tid = std::to_string(buffer.tid);
+
+        // Metadata event naming the thread.
+        out += (first ? "" : ", ");
+        out += "{\"ph\": \"M\", \"name\": \"thread_name\", \"pid\": 1, \"tid\": " + tid + ", ";
+        out += "\"args\": {\"name\": \"" + escape(buffer.name) + "\"}}";
+        first = false;
+
+        for (unsigned id = 0u ; id < buffer.spans.size() ; ++id) {
+          const Span& span = buffer.spans[id];
+
+          out += ", {\"ph\": \"X\", \"pid\": 1, \"tid\": " + tid + ", ";
+          out += "\"cat\": \"" + escape(span.category) + "\", ";
+          out += "\"name\": \"" + escape(span.name) + "\", ";
+          out += "\"ts\": " + std::to_string(span.start) + ", ";
+          out += "\"dur\": " + std::to_string(span.duration) + "}";
+        }
+
+        if (buffer.dropped > 0u) {
+          warn("Dropped " + std::to_string(buffer.dropped) + " span(s) for thread \"" + buffer.name + "\"");
+        }
+      }
+
+      out += "]}";
+
+      return out;
+    }
+
+    void
+    Tracer::dump(const std::string& file) {
+      const std::string trace = toJson();
+
+      std::ofstream out(file, std::ios::trunc);
+      if (!out.is_open()) {
+        error(
+          std::string("Could not dump trace to \"") + file + "\"",
+          std::string("Cannot open file")
+        );
+      }
+
+      out << trace;
+
+      if (!out.good()) {
+        error(
+          std::string("Could not dump trace to \"") + file + "\"",
+          std::string("Failed to write trace")
+        );
+      }
+
+      notice("Dumped trace to \"" + file + "\"");
+    }
+
+    Tracer::Buffer&
+    Tracer::getBuffer() {
+      // Each thread keeps the last buffer it used along with the identifier of
+      // the tracer owning it. The identifiers are never reused so a buffer can
+      // not be attributed to the wrong tracer.
+      static thread_local std::uint64_t owner = 0u;
+      static thread_local Buffer* cached = nullptr;
+
+      if (owner == m_id && cached != nullptr) {
+        return *cached;
+      }
+
+      const std::lock_guard guard(m_locker);
+
+      const std::thread::id thread = std::this_thread::get_id();
+
+      std::unordered_map<std::thread::id, BufferShPtr>::const_iterator it = m_buffers.find(thread);
+      if (it == m_buffers.cend()) {
+        BufferShPtr buffer = std::make_shared<Buffer>();
+
+        buffer->tid = static_cast<unsigned>(m_buffers.size() + 1u);
+        buffer->name = std::string("thread_") + std::to_string(buffer->tid);
+        buffer->dropped = 0u;
+
+        it = m_buffers.emplace(thread, buffer).first;
+      }
+
+      owner = m_id;
+      cached = it->second.get();
+
+      return *cached;
+    }
+
+    std::string
+    Tracer::escape(const std::string& in) {
+      std::string out;
+      out.reserve(in.size());
+
+      for (unsigned id = 0u ; id < in.size() ; ++id) {
+        const char c = in[id];
+
+        if (c == '"' || c == '\\') {
+          out += '\\';
+          out += c;
+        }
+        else if (static_cast<unsigned char>(c) < 0x20u) {
+          out += ' ';
+        }
+        else {
+          out += c;
+        }
+      }
+
+      return out;
+    }
+
+  }
+}
@@ -0,0 +1,184 @@
+#ifndef    TRACER_HH
+# define   TRACER_HH
+
+# include <mutex>
+# include <atomic>
+# include <chrono>
+# include <memory>
+# include <string>
+# include <thread>
+# include <vector>
+# include <cstdint>
+# include <unordered_map>
+# include <core_utils/CoreObject.hh>
+
+namespace sdl {
+  namespace app {
+
+    class Tracer: public utils::CoreObject {
+      public:
+
+        using Clock = std::chrono::steady_clock;
+
+        /**
+         * @brief - Convenience class allowing to record a span covering the
+         *          lifetime of the object. Nothing is recorded if the tracer
+         *          is null or not enabled when the span starts, so that the
+         *          cost of an inactive span is limited to a single load.
+         */
+        class Scope {
+          public:
+
+            Scope(Tracer* tracer,
+                  const char* category,
+                  const std::string& name);
+
+            Scope(Tracer* tracer,
+                  const char* category,
+                  const char* name);
+
+            ~Scope();
+
+            Scope(const Scope&) = delete;
+
+            Scope&
+            operator=(const Scope&) = delete;
+
+          private:
+
+            Tracer* m_tracer;
+            const char* m_category;
+            std::string m_name;
+            Clock::time_point m_start;
+        };
+
+        /**
+         * @brief - Creates a new tracer which is not enabled. Each thread can
+         *          record at most `capacity` spans until the tracer is cleared,
+         *          additional spans are counted as dropped.
+         * @param capacity - the maximum number of spans for each thread.
+         */
+        explicit
+        Tracer(std::size_t capacity = 65536u);
+
+        virtual ~Tracer();
+
+        void
+        setEnabled(bool enabled) noexcept;
+
+        bool
+        isEnabled() const noexcept;
+
+        /**
+         * @brief - Assigns a name to the calling thread. It is displayed in the
+         *          trace viewers in place of the default `thread_x` name.
+         * @param name - the name of the calling thread.
+         */
+        void
+        setThreadName(const std::string& name);
+
+        /**
+         * @brief - Records a span for the calling thread. The span is written in
+         *          a buffer specific to the thread so that concurrent threads do
+         *          not contend with each other.
+         * @param category - the category of the span.
+         * @param name - the name of the span.
+         * @param start - the time at which the span started.
+         * @param end - the time at which the span ended.
+         */
+        void
+        record(const char* category,
+               const std::string& name,
+               const Clock::time_point& start,
+               const Clock::time_point& end);
+
+        /**
+         * @brief - Discards all the spans recorded so far.
+         */
+        void
+        clear();
+
+        /**
+         * @brief - Serializes the spans recorded so far in the Chrome Trace Event
+         *          format, which can be loaded in `chrome://tracing` or Perfetto.
+         * @return - the JSON representation of the trace.
+         */
+        std::string
+        toJson();
+
+        /**
+         * @brief - Writes the result of `toJson` to the input `file`. Any existing
+         *          content is overriden. An error is raised if the file can't be
+         *          written.
+         * @param file - the path of the file to write.
+         */
+        void
+        dump(const std::string& file);
+
+      private:
+
+        /**
+         * @brief - Describes a single span of a thread. Timestamps are expressed
+         *          in microseconds relatively to the creation of the tracer.
+         */
+        struct Span {
+          const char* category;
+          std::string name;
+          std::int64_t start;
+          std::int64_t duration;
+        };
+
+        /**
+         * @brief - The spans recorded by a single thread. The locker is only
+         *          contended when the trace is serialized or cleared.
+         */
+        struct Buffer {
+          std::mutex locker;
+          unsigned tid;
+          std::string name;
+          std::vector<Span> spans;
+          std::uint64_t dropped;
+        };
+
+        using BufferShPtr = std::shared_ptr<Buffer>;
+
+        /**
+         * @brief - Retrieves the buffer associated to the calling thread, creating
+         *          it if needed. The result is cached in a thread local variable
+         *          so that the registry is only accessed once for each thread.
+         * @return - the buffer of the calling thread.
+         */
+        Buffer&
+        getBuffer();
+
+        static
+        std::uint64_t
+        generateID() noexcept;
+
+        static
+        std::string
+        escape(const std::string& in);
+
+      private:
+
+        /**
+         * @brief - Unique identifier of this tracer used to validate the buffers
+         *          cached by each thread.
+         */
+        const std::uint64_t m_id;
+
+        std::atomic_bool m_enabled;
+        std::size_t m_capacity;
+        Clock::time_point m_origin;
+
+        std::mutex m_locker;
+        std::unordered_map<std::thread::id, BufferShPtr> m_buffers;
+    };
+
+    using TracerShPtr = std::shared_ptr<Tracer>;
+  }
+}
+
+# include "Tracer.hxx"
+
+#endif    /* TRACER_HH */
@@ -0,0 +1,70 @@
+#ifndef    TRACER_HXX
+# define   TRACER_HXX
+
+# include "Tracer.hh"
+
+namespace sdl {
+  namespace app {
+
+    inline
+    Tracer::Scope::Scope(Tracer* tracer,
+                         const char* category,
+                         const std::string& name):
+      m_tracer(tracer != nullptr && tracer->isEnabled() ? tracer : nullptr),
+      m_category(category),
+      m_name(m_tracer != nullptr ? name : std::string()),
+      m_start(m_tracer != nullptr ? Clock::now() : Clock::time_point())
+    {}
+
+    inline
+    Tracer::Scope::Scope(Tracer* tracer,
+                         const char* category,
+                         const char* name):
+      m_tracer(tracer != nullptr && tracer->isEnabled() ? tracer : nullptr),
+      m_category(category),
+      m_name(m_tracer != nullptr ? name : ""),
+      m_start(m_tracer != nullptr ? Clock::now() : Clock::time_point())
+    {}
+
+    inline
+    Tracer::Scope::~Scope() {
+      if (m_tracer != nullptr) {
+        m_tracer->record(m_category, m_name, m_start, Clock::now());
+      }
+    }
+
+    inline
+    Tracer::~Tracer() {}
+
+    inline
+    void
+    Tracer::setEnabled(bool enabled) noexcept {
+      m_enabled = enabled;
+    }
+
+    inline
+    bool
+    Tracer::isEnabled() const noexcept {
+      return m_enabled;
+    }
+
+    inline
+    void
+    Tracer::setThreadName(const std::string& name) {
+      Buffer& buffer = getBuffer();
+
+      const std::lock_guard guard(buffer.locker);
+      buffer.name = name;
+    }
+
+    inline
+    std::uint64_t
+    Tracer::generateID() noexcept {
+      static std::atomic<std::uint64_t> next(1u);
+      return next++;
+    }
+
+  }
+}
+
+#endif    /* TRACER_HXX */